@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+// Decides when the GATT session should hold the link open. Keeping it warm avoids
+// a full scan/connect/discovery when the mic turns on, at the cost of radio time.
+// A window with startHour > endHour runs past midnight (e.g. 20-6); equal hours mean never.
+struct KeepWarmPolicy {
+    int startHour = 8;  // Local time, inclusive
+    int endHour = 18;   // Local time, exclusive
+    bool weekdaysOnly = true;
+
+    bool shouldKeepWarm(const std::tm& localTime) const {
+        if (weekdaysOnly && (localTime.tm_wday == 0 || localTime.tm_wday == 6)) {
+            return false;
+        }
+        if (startHour <= endHour) {
+            return localTime.tm_hour >= startHour && localTime.tm_hour < endHour;
+        }
+        return localTime.tm_hour >= startHour || localTime.tm_hour < endHour;
+    }
+};
+
+// Full reconnect counters, reported with the periodic status line
+struct ReconnectStats {
+    uint32_t attempts = 0;
+    uint32_t successes = 0;
+    uint32_t linkDrops = 0;
+    uint32_t sessionResumes = 0;
+    std::chrono::milliseconds lastDuration{ 0 };
+    std::chrono::milliseconds totalDuration{ 0 };
+};
+
+// What the monitor loop does while the LED link is down
+enum class ReconnectAction {
+    Wait,          // Too soon, or a kept-warm session may still bring the link back
+    ResumeSession, // The session restored the link - reuse the cached GATT objects
+    FullReconnect  // Tear down, scan, connect and rediscover
+};
+
+// After a radio drop a maintained GATT session restores the link in the background,
+// which takes the OS a few seconds. Tearing the session down for a scan during that
+// time is the churn keeping warm exists to avoid, so the session gets restoreGrace
+// before falling back to a full reconnect.
+inline ReconnectAction decideReconnect(bool sessionHeld, bool sessionLinkUp,
+    std::chrono::milliseconds sinceDrop, std::chrono::milliseconds sinceAttempt,
+    std::chrono::milliseconds reconnectDelay, std::chrono::milliseconds restoreGrace) {
+    if (sessionHeld) {
+        if (sessionLinkUp) {
+            return ReconnectAction::ResumeSession;
+        }
+        if (sinceDrop < restoreGrace) {
+            return ReconnectAction::Wait;
+        }
+    }
+    return sinceAttempt >= reconnectDelay ? ReconnectAction::FullReconnect : ReconnectAction::Wait;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Microphone state as shown on the LED - values are the byte written to the device
+enum class MicState : uint8_t {
+    Idle = 0,
+    Live = 1,
+    Muted = 2
+};
+
+// A muted endpoint overrides session activity: apps may hold the mic open, but nothing is captured
+inline MicState combineMicState(bool sessionActive, bool muted) {
+    if (!sessionActive) {
+        return MicState::Idle;
+    }
+    return muted ? MicState::Muted : MicState::Live;
+}
+
+inline const char* micStateName(MicState state) {
+    switch (state) {
+    case MicState::Live:
+        return "live";
+    case MicState::Muted:
+        return "muted";
+    default:
+        return "idle";
+    }
+}
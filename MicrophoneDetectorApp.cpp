@@ -7,6 +7,7 @@
 #include <commctrl.h>
 #include <mmdeviceapi.h>
 #include <audiopolicy.h>
+#include <endpointvolume.h>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -17,6 +18,16 @@
 #include <mutex>
 #include <iomanip>
 #include <atomic>
+#include <memory>
+#include <fstream>
+
+#include "MicState.h"
+#include "StateFanout.h"
+#include "SubscriberServer.h"
+#include "ScanMatch.h"
+#include "KeepWarmPolicy.h"
+#include "RuntimeConfig.h"
+#include "SpanTracer.h"
 
 // Windows BLE headers
 #include <winrt/base.h>
@@ -47,6 +58,8 @@ using namespace Windows::Storage::Streams;
 #define ID_TRAY_RECONNECT 1003
 #define ID_TRAY_EXIT 1004
 #define ID_TRAY_ABOUT 1005
+#define ID_TRAY_TOGGLE_TRACING 1006
+#define ID_TRAY_EXPORT_TRACE 1007
 
 // Global variables
 HWND g_hWnd = nullptr;
@@ -56,7 +69,6 @@ std::atomic<bool> g_shouldExit{ false };
 std::atomic<bool> g_consoleVisible{ false };
 std::mutex g_logMutex;
 std::vector<std::string> g_logMessages;
-const size_t MAX_LOG_MESSAGES = 100;
 
 // Console management variables
 HWND g_consoleWindow = nullptr;
@@ -66,6 +78,123 @@ bool g_consoleAllocated = false;
 void HideConsole();
 void ShowConsole();
 void CleanupConsole();
+void LogMessage(const std::string& message);
+
+// Runtime configuration - MicrophoneLEDMonitor.ini next to the executable, reloaded
+// when the file changes. Readers take an immutable snapshot; parsing and validation
+// only run on the watcher thread, and a bad file keeps the previous config.
+class ConfigManager {
+private:
+    RuntimeConfigStore store;
+    bool fileLoaded = false;
+    bool missingReported = false; // Other files in the directory change too
+    std::wstring directory;
+    std::wstring path;
+    FILETIME lastWriteTime = {};
+    std::thread watcherThread;
+    HANDLE stopEvent = nullptr;
+
+public:
+    ~ConfigManager() {
+        stop();
+    }
+
+    std::shared_ptr<const RuntimeConfig> get() const {
+        return store.get();
+    }
+
+    void start() {
+        wchar_t modulePath[MAX_PATH];
+        DWORD length = GetModuleFileName(nullptr, modulePath, MAX_PATH);
+        directory = std::wstring(modulePath, length);
+        directory.erase(directory.find_last_of(L"\\/") + 1);
+        path = directory + L"MicrophoneLEDMonitor.ini";
+
+        reload();
+
+        stopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (stopEvent) {
+            watcherThread = std::thread(&ConfigManager::watchLoop, this);
+        }
+    }
+
+    void stop() {
+        if (watcherThread.joinable()) {
+            SetEvent(stopEvent);
+            watcherThread.join();
+        }
+        if (stopEvent) {
+            CloseHandle(stopEvent);
+            stopEvent = nullptr;
+        }
+    }
+
+private:
+    void watchLoop() {
+        HANDLE change = FindFirstChangeNotification(directory.c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (change == INVALID_HANDLE_VALUE) {
+            LogMessage("Failed to watch config file - changes need a restart");
+            return;
+        }
+
+        HANDLE handles[] = { stopEvent, change };
+        while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1) {
+            // Editors often write in several steps - let the save settle first
+            if (WaitForSingleObject(stopEvent, 200) == WAIT_OBJECT_0) {
+                break;
+            }
+            reload();
+            if (!FindNextChangeNotification(change)) {
+                LogMessage("Stopped watching config file (error " + std::to_string(GetLastError()) +
+                    ") - changes need a restart");
+                break;
+            }
+        }
+
+        FindCloseChangeNotification(change);
+    }
+
+    void reload() {
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesEx(path.c_str(), GetFileExInfoStandard, &attributes)) {
+            if (fileLoaded) {
+                store.reset();
+                fileLoaded = false;
+                lastWriteTime = {};
+                LogMessage("Config file removed - reverted to " + get()->profile + " profile");
+            }
+            else if (!missingReported) {
+                LogMessage("No config file found - using " + get()->profile + " profile");
+            }
+            missingReported = true;
+            return;
+        }
+        missingReported = false;
+
+        if (CompareFileTime(&attributes.ftLastWriteTime, &lastWriteTime) == 0) {
+            return; // Change was to another file in the directory
+        }
+
+        std::ifstream in(path);
+        if (!in) {
+            LogMessage("Config file busy - will retry on next change");
+            return;
+        }
+        lastWriteTime = attributes.ftLastWriteTime;
+
+        std::string error;
+        if (!store.apply(in, error)) {
+            LogMessage("Config rejected (" + error + ") - keeping " + get()->profile + " profile");
+            return;
+        }
+
+        fileLoaded = true;
+        LogMessage("Config applied - " + get()->profile + " profile");
+    }
+};
+
+ConfigManager g_config;
 
 // Logging function
 void LogMessage(const std::string& message) {
@@ -80,8 +209,9 @@ void LogMessage(const std::string& message) {
     oss << "[" << std::put_time(&tm, "%H:%M:%S") << "] " << message;
 
     g_logMessages.push_back(oss.str());
-    if (g_logMessages.size() > MAX_LOG_MESSAGES) {
-        g_logMessages.erase(g_logMessages.begin());
+    size_t maxLogMessages = g_config.get()->maxLogMessages;
+    if (g_logMessages.size() > maxLogMessages) {
+        g_logMessages.erase(g_logMessages.begin(), g_logMessages.end() - maxLogMessages);
     }
 
     if (g_consoleVisible && g_consoleWindow) {
@@ -140,6 +270,39 @@ void CleanupConsole() {
     }
 }
 
+// Span tracer - enable from the tray menu or with --trace
+Tracer g_tracer;
+
+std::string WideToUtf8(const std::wstring& text) {
+    int length = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), nullptr, 0, nullptr, nullptr);
+    std::string result(length > 0 ? length : 0, '\0');
+    if (length > 0) {
+        WideCharToMultiByte(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), &result[0], length, nullptr, nullptr);
+    }
+    return result;
+}
+
+std::wstring GetTraceExportPath() {
+    wchar_t tempPath[MAX_PATH];
+    DWORD length = GetTempPath(MAX_PATH, tempPath);
+    std::wstring path = (length > 0 && length < MAX_PATH) ? std::wstring(tempPath, length) : L".\\";
+    return path + L"MicrophoneLEDMonitor-trace.json";
+}
+
+void ExportTrace() {
+    std::wstring path = GetTraceExportPath();
+    std::ofstream out(path, std::ios::trunc);
+    if (out) {
+        g_tracer.exportChromeTrace(out, GetCurrentProcessId());
+    }
+    if (out) {
+        LogMessage("Trace exported to " + WideToUtf8(path));
+    }
+    else {
+        LogMessage("Failed to export trace");
+    }
+}
+
 // System tray functions
 void AddTrayIcon(HWND hWnd) {
     g_nid.cbSize = sizeof(NOTIFYICONDATA);
@@ -156,11 +319,11 @@ void RemoveTrayIcon() {
     Shell_NotifyIcon(NIM_DELETE, &g_nid);
 }
 
-void UpdateTrayIcon(bool connected, bool micActive) {
+void UpdateTrayIcon(bool connected, MicState micState) {
     std::wstring tooltip = L"Microphone LED Monitor\n";
     tooltip += connected ? L"Connected" : L"Disconnected";
     tooltip += L" | Mic: ";
-    tooltip += micActive ? L"ACTIVE" : L"Inactive";
+    tooltip += micState == MicState::Live ? L"ACTIVE" : (micState == MicState::Muted ? L"MUTED" : L"Inactive");
 
     wcscpy_s(g_nid.szTip, tooltip.c_str());
     g_nid.uFlags = NIF_TIP;
@@ -178,12 +341,16 @@ void ShowContextMenu(HWND hWnd) {
         AppendMenu(g_hMenu, MF_SEPARATOR, 0, nullptr);
         AppendMenu(g_hMenu, MF_STRING, ID_TRAY_RECONNECT, L"Reconnect");
         AppendMenu(g_hMenu, MF_SEPARATOR, 0, nullptr);
+        AppendMenu(g_hMenu, MF_STRING, ID_TRAY_TOGGLE_TRACING, L"Enable Tracing");
+        AppendMenu(g_hMenu, MF_STRING, ID_TRAY_EXPORT_TRACE, L"Export Trace");
+        AppendMenu(g_hMenu, MF_SEPARATOR, 0, nullptr);
         AppendMenu(g_hMenu, MF_STRING, ID_TRAY_ABOUT, L"About");
         AppendMenu(g_hMenu, MF_STRING, ID_TRAY_EXIT, L"Exit");
     }
 
     EnableMenuItem(g_hMenu, ID_TRAY_SHOW_CONSOLE, g_consoleVisible ? MF_GRAYED : MF_ENABLED);
     EnableMenuItem(g_hMenu, ID_TRAY_HIDE_CONSOLE, g_consoleVisible ? MF_ENABLED : MF_GRAYED);
+    CheckMenuItem(g_hMenu, ID_TRAY_TOGGLE_TRACING, g_tracer.isEnabled() ? MF_CHECKED : MF_UNCHECKED);
 
     SetForegroundWindow(hWnd);
     TrackPopupMenu(g_hMenu, TPM_BOTTOMALIGN | TPM_LEFTALIGN, pt.x, pt.y, 0, hWnd, nullptr);
@@ -195,12 +362,21 @@ private:
     BluetoothLEDevice device{ nullptr };
     GattCharacteristic switchCharacteristic{ nullptr };
     GattDeviceService gattService{ nullptr };
+    GattSession gattSession{ nullptr };
+    bool keepingWarm = false;
+    // Set only when the radio link went down under a working connection. Cached GATT
+    // objects may be reused after that; after a failed write they may not.
+    bool linkDropped = false;
+    std::chrono::steady_clock::time_point linkDroppedAt;
+    ReconnectStats stats;
     std::atomic<bool> isConnected{ false };
     std::atomic<bool> isConnecting{ false };
     std::chrono::steady_clock::time_point lastConnectionAttempt;
-    const std::chrono::seconds RECONNECT_DELAY{ 3 };
-    const std::chrono::seconds SCAN_TIMEOUT{ 8 };
+    const int16_t SCAN_RSSI_THRESHOLD_DBM = -90;
+    const std::wstring LED_SERVICE_UUID = L"19B10000-E8F2-537E-4F6C-D104768A1214";
     const std::wstring SWITCH_CHARACTERISTIC_UUID = L"19B10001-E8F2-537E-4F6C-D104768A1214";
+    winrt::guid ledServiceUuid{};
+    winrt::guid switchUuid{};
     winrt::event_token connectionStatusToken{};
     std::mutex connectionMutex;
 
@@ -227,7 +403,9 @@ private:
 
 public:
     ArduinoBLEController() {
-        lastConnectionAttempt = std::chrono::steady_clock::now() - RECONNECT_DELAY;
+        lastConnectionAttempt = std::chrono::steady_clock::now() - g_config.get()->reconnectDelay;
+        ledServiceUuid = parseUUID(LED_SERVICE_UUID);
+        switchUuid = parseUUID(SWITCH_CHARACTERISTIC_UUID);
     }
 
     ~ArduinoBLEController() {
@@ -236,8 +414,7 @@ public:
 
     bool shouldAttemptReconnect() {
         std::lock_guard<std::mutex> lock(connectionMutex);
-        auto now = std::chrono::steady_clock::now();
-        return !isConnected && !isConnecting && (now - lastConnectionAttempt) >= RECONNECT_DELAY;
+        return !isConnected && !isConnecting && nextReconnectAction() != ReconnectAction::Wait;
     }
 
     bool getConnectionStatus() {
@@ -250,7 +427,7 @@ public:
             bool connected = device.ConnectionStatus() == BluetoothConnectionStatus::Connected;
             if (!connected && isConnected) {
                 LogMessage("Device connection status changed to disconnected");
-                isConnected = false;
+                markLinkDropped();
             }
             return connected;
         }
@@ -272,29 +449,66 @@ public:
             return false; // Already attempting connection
         }
 
+        ReconnectAction action = nextReconnectAction();
+        if (action == ReconnectAction::Wait) {
+            return false; // Session still restoring, or too soon after the last attempt
+        }
+        if (action == ReconnectAction::ResumeSession) {
+            // The kept-warm session brought the link back after a real drop
+            LogMessage("Reusing link held by GATT session");
+            stats.sessionResumes++;
+            linkDropped = false;
+            isConnected = true;
+            return true;
+        }
+
+        auto config = g_config.get();
         lastConnectionAttempt = std::chrono::steady_clock::now();
         isConnecting = true;
+        TraceSpan connectSpan(g_tracer, "connectToArduino");
 
         try {
+            if (linkDropped && gattSession && keepingWarm) {
+                LogMessage("GATT session did not restore the link - falling back to full reconnect");
+            }
+
+            // Only full reconnects count as attempts
+            stats.attempts++;
+            auto connectStart = std::chrono::steady_clock::now();
+
             // Clean up any existing connections first
             cleanupConnection();
 
             LogMessage("Scanning for Arduino BLE device...");
+            TraceSpan scanSpan(g_tracer, "scan");
 
+            // Let the radio stack drop everything that isn't our LED service in range,
+            // so the callback only runs for candidate devices. The firmware advertises
+            // the service UUID in the primary packet, so passive scanning is enough.
             BluetoothLEAdvertisementWatcher watcher;
-            watcher.ScanningMode(BluetoothLEScanningMode::Active);
-
-            std::atomic<bool> deviceFound{ false };
-            uint64_t targetDeviceAddress = 0;
+            watcher.ScanningMode(BluetoothLEScanningMode::Passive);
+            watcher.AdvertisementFilter().Advertisement().ServiceUuids().Append(ledServiceUuid);
+            watcher.SignalStrengthFilter().InRangeThresholdInDBm(SCAN_RSSI_THRESHOLD_DBM);
+
+            // Shared with the callback by value - revoking the handler does not wait for
+            // callbacks already running on a pool thread, so they must not touch our stack
+            struct ScanState {
+                ScanMatch match;
+                winrt::handle foundEvent{ CreateEvent(nullptr, TRUE, FALSE, nullptr) };
+            };
+            auto scan = std::make_shared<ScanState>();
+            if (!scan->foundEvent) {
+                // Without the event the wait loop below would spin for the whole scan timeout
+                LogMessage("Failed to create scan event - skipping scan");
+                isConnecting = false;
+                return false;
+            }
 
-            auto token = watcher.Received([&](BluetoothLEAdvertisementWatcher const&, BluetoothLEAdvertisementReceivedEventArgs const& args) {
-                if (!deviceFound) {
-                    std::wstring localName = args.Advertisement().LocalName().c_str();
-                    if (localName == L"LED") {
-                        LogMessage("Found Arduino LED device!");
-                        targetDeviceAddress = args.BluetoothAddress();
-                        deviceFound = true;
-                    }
+            // Runs on a thread pool thread - no allocation, first match wins and stops the scan
+            auto token = watcher.Received([scan](BluetoothLEAdvertisementWatcher const& sender, BluetoothLEAdvertisementReceivedEventArgs const& args) {
+                if (scan->match.claim(args.BluetoothAddress())) {
+                    SetEvent(scan->foundEvent.get());
+                    sender.Stop();
                 }
                 });
 
@@ -302,12 +516,20 @@ public:
 
             // Wait for device discovery with timeout
             auto startTime = std::chrono::steady_clock::now();
-            while (!deviceFound && !g_shouldExit &&
-                (std::chrono::steady_clock::now() - startTime) < SCAN_TIMEOUT) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            while (!scan->match.found() && !g_shouldExit &&
+                (std::chrono::steady_clock::now() - startTime) < config->scanTimeout) {
+                WaitForSingleObject(scan->foundEvent.get(), 100);
             }
 
             watcher.Stop();
+            watcher.Received(token);
+            scanSpan.end();
+
+            uint64_t targetDeviceAddress = scan->match.matchedAddress();
+            bool deviceFound = targetDeviceAddress != 0;
+            if (deviceFound) {
+                LogMessage("Found Arduino LED device!");
+            }
 
             if (g_shouldExit || !deviceFound) {
                 if (!deviceFound) {
@@ -319,8 +541,10 @@ public:
 
             // Connect to device
             LogMessage("Connecting to Arduino...");
+            TraceSpan fromAddressSpan(g_tracer, "FromBluetoothAddressAsync");
             auto deviceTask = BluetoothLEDevice::FromBluetoothAddressAsync(targetDeviceAddress);
             device = deviceTask.get();
+            fromAddressSpan.end();
 
             if (!device) {
                 LogMessage("Failed to create device object");
@@ -328,6 +552,18 @@ public:
                 return false;
             }
 
+            // A maintained session keeps the link up across idle periods instead of letting
+            // Windows tear it down; it also covers the GATT enumeration below
+            try {
+                gattSession = GattSession::FromDeviceIdAsync(device.BluetoothDeviceId()).get();
+                keepingWarm = false;
+                applyKeepWarmPolicy();
+            }
+            catch (...) {
+                LogMessage("Failed to open GATT session - link will not be kept warm");
+                gattSession = nullptr;
+            }
+
             // Set up connection status change handler
             connectionStatusToken = device.ConnectionStatusChanged([this](BluetoothLEDevice const& sender, auto const&) {
                 try {
@@ -335,8 +571,21 @@ public:
                     if (status == BluetoothConnectionStatus::Disconnected) {
                         LogMessage("Device disconnected - connection status changed event");
                         std::lock_guard<std::mutex> lock(connectionMutex);
+                        if (isConnected) {
+                            markLinkDropped();
+                        }
                         isConnected = false;
                     }
+                    else if (status == BluetoothConnectionStatus::Connected) {
+                        // The GATT session re-established the link - cached GATT objects stay valid
+                        std::lock_guard<std::mutex> lock(connectionMutex);
+                        if (!isConnected && !isConnecting && linkDropped && switchCharacteristic) {
+                            LogMessage("Link restored by GATT session - skipping full reconnect");
+                            stats.sessionResumes++;
+                            linkDropped = false;
+                            isConnected = true;
+                        }
+                    }
                 }
                 catch (...) {
                     LogMessage("Error in connection status change handler");
@@ -344,10 +593,11 @@ public:
                 });
 
             // Get GATT services with retry logic
-            int retries = 3;
+            int retries = config->gattRetries;
             GattDeviceServicesResult gattResult{ nullptr };
 
             while (retries > 0 && !g_shouldExit) {
+                TraceSpan gattSpan(g_tracer, "GetGattServicesAsync");
                 try {
                     gattResult = device.GetGattServicesAsync().get();
                     if (gattResult.Status() == GattCommunicationStatus::Success) {
@@ -379,18 +629,23 @@ public:
             }
 
             // Find the switch characteristic
-            winrt::guid switchUuid = parseUUID(SWITCH_CHARACTERISTIC_UUID);
-
+            TraceSpan discoverySpan(g_tracer, "characteristic discovery");
             for (auto&& service : gattResult.Services()) {
                 auto charResult = service.GetCharacteristicsAsync().get();
                 if (charResult.Status() == GattCommunicationStatus::Success) {
                     for (auto&& characteristic : charResult.Characteristics()) {
                         if (characteristic.Uuid() == switchUuid) {
-                            LogMessage("Found switch characteristic - Connected!");
                             switchCharacteristic = characteristic;
                             gattService = service;
                             isConnected = true;
                             isConnecting = false;
+
+                            stats.successes++;
+                            stats.lastDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - connectStart);
+                            stats.totalDuration += stats.lastDuration;
+                            LogMessage("Found switch characteristic - Connected! (" +
+                                std::to_string(stats.lastDuration.count()) + " ms)");
                             return true;
                         }
                     }
@@ -417,7 +672,8 @@ public:
         }
     }
 
-    bool setLEDState(bool state) {
+    bool setLEDState(MicState state) {
+        TraceSpan span(g_tracer, "setLEDState");
         std::lock_guard<std::mutex> lock(connectionMutex);
 
         if (!isConnected || !switchCharacteristic) {
@@ -427,33 +683,38 @@ public:
         try {
             if (!device || device.ConnectionStatus() != BluetoothConnectionStatus::Connected) {
                 LogMessage("Device disconnected during LED operation");
+                if (switchCharacteristic) {
+                    markLinkDropped();
+                }
                 isConnected = false;
                 return false;
             }
 
             DataWriter writer;
-            writer.WriteByte(state ? 1 : 0);
+            writer.WriteByte(static_cast<uint8_t>(state));
             IBuffer buffer = writer.DetachBuffer();
 
+            TraceSpan writeSpan(g_tracer, "WriteValueAsync");
             auto result = switchCharacteristic.WriteValueAsync(buffer).get();
+            writeSpan.end();
             if (result == GattCommunicationStatus::Success) {
-                LogMessage(state ? "LED turned ON" : "LED turned OFF");
+                LogMessage(std::string("LED set to ") + micStateName(state));
                 return true;
             }
             else {
                 LogMessage("Failed to send LED command - communication error");
-                isConnected = false;
+                discardFailedCharacteristic();
                 return false;
             }
         }
         catch (const std::exception& ex) {
             LogMessage(std::string("LED control error: ") + ex.what());
-            isConnected = false;
+            discardFailedCharacteristic();
             return false;
         }
         catch (...) {
             LogMessage("Unknown LED control error");
-            isConnected = false;
+            discardFailedCharacteristic();
             return false;
         }
     }
@@ -463,17 +724,108 @@ public:
         cleanupConnection();
     }
 
+    // Re-evaluates the keep-warm policy; called from the monitor loop
+    void updateKeepWarm() {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        applyKeepWarmPolicy();
+    }
+
+    std::string getReconnectSummary() {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        auto average = stats.successes ? stats.totalDuration.count() / stats.successes : 0;
+        return "Reconnects: " + std::to_string(stats.successes) + "/" + std::to_string(stats.attempts) +
+            " succeeded, avg " + std::to_string(average) + " ms, last " + std::to_string(stats.lastDuration.count()) +
+            " ms, link drops " + std::to_string(stats.linkDrops) + ", session resumes " + std::to_string(stats.sessionResumes);
+    }
+
     void forceReconnect() {
         LogMessage("Force reconnect requested");
         disconnect();
-        lastConnectionAttempt = std::chrono::steady_clock::now() - RECONNECT_DELAY;
+        lastConnectionAttempt = std::chrono::steady_clock::now() - g_config.get()->reconnectDelay;
     }
 
 private:
+    void markLinkDropped() {
+        // This method should be called with connectionMutex already locked
+        stats.linkDrops++;
+        linkDropped = true;
+        linkDroppedAt = std::chrono::steady_clock::now();
+        isConnected = false;
+    }
+
+    ReconnectAction nextReconnectAction() {
+        // This method should be called with connectionMutex already locked
+        auto config = g_config.get();
+        auto now = std::chrono::steady_clock::now();
+
+        // A kept-warm session restores the link on its own; the scan timeout bounds how
+        // long that may take before a full reconnect would have been quicker anyway
+        bool sessionHeld = keepingWarm && linkDropped && gattSession && switchCharacteristic && device;
+        bool sessionLinkUp = false;
+        if (sessionHeld) {
+            try {
+                sessionLinkUp = device.ConnectionStatus() == BluetoothConnectionStatus::Connected;
+            }
+            catch (...) {
+                sessionHeld = false;
+            }
+        }
+
+        return decideReconnect(sessionHeld, sessionLinkUp,
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - linkDroppedAt),
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - lastConnectionAttempt),
+            config->reconnectDelay, config->scanTimeout);
+    }
+
+    void applyKeepWarmPolicy() {
+        // This method should be called with connectionMutex already locked
+        if (!gattSession) {
+            return;
+        }
+
+        auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        struct tm tm;
+        localtime_s(&tm, &time_t);
+        bool keepWarm = g_config.get()->keepWarm.shouldKeepWarm(tm);
+        if (keepWarm == keepingWarm) {
+            return;
+        }
+
+        try {
+            gattSession.MaintainConnection(keepWarm);
+            keepingWarm = keepWarm;
+            LogMessage(keepWarm ? "Keeping BLE link warm (work hours)" : "Releasing BLE link outside work hours");
+        }
+        catch (...) {
+            LogMessage("Failed to update GATT session keep-alive");
+        }
+    }
+
+    void discardFailedCharacteristic() {
+        // This method should be called with connectionMutex already locked.
+        // The link may still be up, but the cached characteristic can't be trusted -
+        // force the next reconnect through full cleanup and rediscovery.
+        isConnected = false;
+        linkDropped = false;
+        switchCharacteristic = nullptr;
+    }
+
     void cleanupConnection() {
         // This method should be called with connectionMutex already locked
         isConnected = false;
         isConnecting = false;
+        linkDropped = false;
+
+        if (gattSession) {
+            try {
+                gattSession.Close();
+            }
+            catch (...) {
+                // Ignore cleanup errors
+            }
+            gattSession = nullptr;
+            keepingWarm = false;
+        }
 
         if (device && connectionStatusToken.value != 0) {
             try {
@@ -511,16 +863,75 @@ private:
     }
 };
 
+// Endpoint volume callback - tracks hardware/software mute without polling
+class EndpointVolumeCallback : public IAudioEndpointVolumeCallback {
+private:
+    std::atomic<ULONG> refCount{ 1 };
+    std::atomic<bool> muted{ false };
+    HANDLE changeEvent;
+
+public:
+    explicit EndpointVolumeCallback(HANDLE changeEvent) : changeEvent(changeEvent) {}
+
+    // A zero capture level is treated the same as mute
+    void setMuted(BOOL isMuted, float masterVolume) {
+        bool newMuted = isMuted != FALSE || masterVolume <= 0.0f;
+        if (muted.exchange(newMuted) != newMuted && changeEvent) {
+            SetEvent(changeEvent);
+        }
+    }
+
+    bool isMuted() const {
+        return muted;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override {
+        return ++refCount;
+    }
+
+    ULONG STDMETHODCALLTYPE Release() override {
+        ULONG count = --refCount;
+        if (count == 0) {
+            delete this;
+        }
+        return count;
+    }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvInterface) override {
+        if (!ppvInterface) {
+            return E_POINTER;
+        }
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(IAudioEndpointVolumeCallback)) {
+            AddRef();
+            *ppvInterface = static_cast<IAudioEndpointVolumeCallback*>(this);
+            return S_OK;
+        }
+        *ppvInterface = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    HRESULT STDMETHODCALLTYPE OnNotify(PAUDIO_VOLUME_NOTIFICATION_DATA pNotify) override {
+        if (pNotify) {
+            setMuted(pNotify->bMuted, pNotify->fMasterVolume);
+        }
+        return S_OK;
+    }
+};
+
 // Microphone Monitor
 class MicrophoneMonitor {
 private:
     IMMDeviceEnumerator* pEnumerator;
     IMMDevice* pDevice;
     IAudioSessionManager2* pSessionManager;
+    IAudioEndpointVolume* pEndpointVolume;
+    EndpointVolumeCallback* pVolumeCallback;
+    HANDLE changeEvent;
     bool initialized;
 
 public:
-    MicrophoneMonitor() : pEnumerator(nullptr), pDevice(nullptr), pSessionManager(nullptr), initialized(false) {}
+    MicrophoneMonitor() : pEnumerator(nullptr), pDevice(nullptr), pSessionManager(nullptr),
+        pEndpointVolume(nullptr), pVolumeCallback(nullptr), changeEvent(nullptr), initialized(false) {}
 
     ~MicrophoneMonitor() {
         cleanup();
@@ -556,6 +967,8 @@ public:
             return false;
         }
 
+        initializeMuteTracking();
+
         initialized = true;
         LogMessage("Microphone monitor initialized");
         return true;
@@ -596,8 +1009,68 @@ public:
         return micInUse;
     }
 
+    bool isMicrophoneMuted() {
+        return pVolumeCallback && pVolumeCallback->isMuted();
+    }
+
+    MicState getMicrophoneState() {
+        return combineMicState(isMicrophoneInUse(), isMicrophoneMuted());
+    }
+
+    // Sleeps until the timeout elapses or a mute/volume change is reported
+    void waitForChange(std::chrono::milliseconds timeout) {
+        if (changeEvent) {
+            WaitForSingleObject(changeEvent, static_cast<DWORD>(timeout.count()));
+        }
+        else {
+            std::this_thread::sleep_for(timeout);
+        }
+    }
+
 private:
+    void initializeMuteTracking() {
+        // Mute awareness is optional - fall back to session activity alone if unavailable
+        HRESULT hr = pDevice->Activate(__uuidof(IAudioEndpointVolume), CLSCTX_ALL,
+            nullptr, (void**)&pEndpointVolume);
+        if (FAILED(hr)) {
+            LogMessage("Failed to activate endpoint volume - mute state unavailable");
+            return;
+        }
+
+        changeEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        pVolumeCallback = new EndpointVolumeCallback(changeEvent);
+
+        BOOL muted = FALSE;
+        float volume = 1.0f;
+        if (SUCCEEDED(pEndpointVolume->GetMute(&muted)) &&
+            SUCCEEDED(pEndpointVolume->GetMasterVolumeLevelScalar(&volume))) {
+            pVolumeCallback->setMuted(muted, volume);
+        }
+
+        hr = pEndpointVolume->RegisterControlChangeNotify(pVolumeCallback);
+        if (FAILED(hr)) {
+            LogMessage("Failed to register endpoint volume callback - mute state unavailable");
+            pVolumeCallback->Release();
+            pVolumeCallback = nullptr;
+        }
+    }
+
     void cleanup() {
+        if (pEndpointVolume) {
+            if (pVolumeCallback) {
+                pEndpointVolume->UnregisterControlChangeNotify(pVolumeCallback);
+            }
+            pEndpointVolume->Release();
+            pEndpointVolume = nullptr;
+        }
+        if (pVolumeCallback) {
+            pVolumeCallback->Release();
+            pVolumeCallback = nullptr;
+        }
+        if (changeEvent) {
+            CloseHandle(changeEvent);
+            changeEvent = nullptr;
+        }
         if (pSessionManager) {
             pSessionManager->Release();
             pSessionManager = nullptr;
@@ -614,9 +1087,275 @@ private:
     }
 };
 
+// Named pipe transport for SubscriberServer - overlapped I/O, every completion is
+// reported through an event the broadcaster waits on.
+class NamedPipeTransport {
+public:
+    struct Connection {
+        HANDLE pipe = INVALID_HANDLE_VALUE;
+        OVERLAPPED writeOverlapped = {};
+        OVERLAPPED readOverlapped = {};
+        char readBuffer[64];
+    };
+
+    OVERLAPPED connectOverlapped = {};
+
+    ListenResult listen() {
+        listenPipe = CreateNamedPipe(PIPE_NAME, PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+            PIPE_TYPE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS, PIPE_UNLIMITED_INSTANCES,
+            PIPE_BUFFER_SIZE, PIPE_BUFFER_SIZE, 0, nullptr);
+        if (listenPipe == INVALID_HANDLE_VALUE) {
+            LogMessage("Failed to create subscriber pipe");
+            return ListenResult::Failed;
+        }
+
+        ResetEvent(connectOverlapped.hEvent);
+        if (ConnectNamedPipe(listenPipe, &connectOverlapped)) {
+            return ListenResult::Pending; // Completion is still signalled through the event
+        }
+
+        DWORD error = GetLastError();
+        if (error == ERROR_IO_PENDING) {
+            return ListenResult::Pending;
+        }
+        if (error == ERROR_PIPE_CONNECTED) {
+            // Client connected between create and connect - no overlapped result to collect
+            return ListenResult::Connected;
+        }
+
+        LogMessage("Failed to listen on subscriber pipe (error " + std::to_string(error) + ")");
+        CloseHandle(listenPipe);
+        listenPipe = INVALID_HANDLE_VALUE;
+        return ListenResult::Failed;
+    }
+
+    void cancelListen() {
+        if (listenPipe == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        DWORD transferred = 0;
+        CancelIoEx(listenPipe, &connectOverlapped);
+        GetOverlappedResult(listenPipe, &connectOverlapped, &transferred, TRUE);
+        CloseHandle(listenPipe);
+        listenPipe = INVALID_HANDLE_VALUE;
+    }
+
+    bool accept(Connection& connection, bool synchronous) {
+        HANDLE pipe = listenPipe;
+        listenPipe = INVALID_HANDLE_VALUE;
+
+        DWORD transferred = 0;
+        if (!synchronous && !GetOverlappedResult(pipe, &connectOverlapped, &transferred, FALSE)) {
+            CloseHandle(pipe);
+            return false;
+        }
+
+        connection.pipe = pipe;
+        connection.writeOverlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        connection.readOverlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (!connection.writeOverlapped.hEvent || !connection.readOverlapped.hEvent) {
+            close(connection, false, false);
+            release(connection);
+            return false;
+        }
+        return true;
+    }
+
+    bool beginWrite(Connection& connection, const std::string& message) {
+        // Completion (synchronous or not) is always reported through the event
+        return WriteFile(connection.pipe, message.data(), static_cast<DWORD>(message.size()),
+            nullptr, &connection.writeOverlapped) || GetLastError() == ERROR_IO_PENDING;
+    }
+
+    bool beginRead(Connection& connection) {
+        // ERROR_BROKEN_PIPE here means the client has already gone
+        return ReadFile(connection.pipe, connection.readBuffer, sizeof(connection.readBuffer),
+            nullptr, &connection.readOverlapped) || GetLastError() == ERROR_IO_PENDING;
+    }
+
+    bool finishWrite(Connection& connection) {
+        return finish(connection, connection.writeOverlapped);
+    }
+
+    bool finishRead(Connection& connection) {
+        return finish(connection, connection.readOverlapped);
+    }
+
+    void close(Connection& connection, bool writePending, bool readPending) {
+        if (connection.pipe == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        // Outstanding I/O must finish before its OVERLAPPED and buffers are released
+        DWORD transferred = 0;
+        if (writePending || readPending) {
+            CancelIoEx(connection.pipe, nullptr);
+        }
+        if (writePending) {
+            GetOverlappedResult(connection.pipe, &connection.writeOverlapped, &transferred, TRUE);
+        }
+        if (readPending) {
+            GetOverlappedResult(connection.pipe, &connection.readOverlapped, &transferred, TRUE);
+        }
+
+        CloseHandle(connection.pipe);
+        connection.pipe = INVALID_HANDLE_VALUE;
+    }
+
+    void release(Connection& connection) {
+        if (connection.writeOverlapped.hEvent) {
+            CloseHandle(connection.writeOverlapped.hEvent);
+            connection.writeOverlapped.hEvent = nullptr;
+        }
+        if (connection.readOverlapped.hEvent) {
+            CloseHandle(connection.readOverlapped.hEvent);
+            connection.readOverlapped.hEvent = nullptr;
+        }
+    }
+
+    void log(const std::string& message) {
+        LogMessage(message);
+    }
+
+private:
+    const wchar_t* PIPE_NAME = L"\\\\.\\pipe\\MicrophoneLEDMonitor";
+    static const DWORD PIPE_BUFFER_SIZE = 4096;
+
+    HANDLE listenPipe = INVALID_HANDLE_VALUE;
+
+    bool finish(Connection& connection, OVERLAPPED& overlapped) {
+        DWORD transferred = 0;
+        BOOL ok = GetOverlappedResult(connection.pipe, &overlapped, &transferred, FALSE);
+        ResetEvent(overlapped.hEvent);
+        return ok != FALSE;
+    }
+};
+
+// Local state broadcaster - pushes state changes to other tools over a named pipe.
+// A single server thread services every subscriber with overlapped I/O; StateFanout
+// decides what each subscriber is sent, so a slow reader never blocks the monitor,
+// and SubscriberServer keeps a read posted per subscriber so a client that goes
+// away is noticed immediately rather than on the next state change.
+class StateBroadcaster {
+private:
+    // Wait slots: stop, state change, pending connect, then write + read per subscriber
+    static const size_t MAX_SUBSCRIBERS = (MAXIMUM_WAIT_OBJECTS - 3) / 2;
+
+    std::thread serverThread;
+    HANDLE stopEvent = nullptr;
+    HANDLE stateEvent = nullptr;
+    StateFanout fanout;
+    NamedPipeTransport transport;
+    SubscriberServer<NamedPipeTransport> server{ transport, fanout, MAX_SUBSCRIBERS };
+
+public:
+    ~StateBroadcaster() {
+        stop();
+    }
+
+    bool start() {
+        if (serverThread.joinable()) {
+            return true;
+        }
+
+        stopEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        stateEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        transport.connectOverlapped.hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+        if (!stopEvent || !stateEvent || !transport.connectOverlapped.hEvent) {
+            LogMessage("Failed to create subscriber pipe events");
+            closeEvents();
+            return false;
+        }
+
+        serverThread = std::thread(&StateBroadcaster::serverLoop, this);
+        return true;
+    }
+
+    void stop() {
+        if (!serverThread.joinable()) {
+            return;
+        }
+
+        SetEvent(stopEvent);
+        serverThread.join();
+        closeEvents();
+    }
+
+    // Called from the monitor thread - never touches a pipe
+    void publish(const MonitorSnapshot& snapshot) {
+        if (fanout.publish(snapshot) && stateEvent) {
+            SetEvent(stateEvent);
+        }
+    }
+
+private:
+    void serverLoop() {
+        LogMessage("State subscriber pipe listening");
+        server.start();
+
+        std::vector<HANDLE> waitHandles;
+        while (true) {
+            waitHandles.clear();
+            waitHandles.push_back(stopEvent);
+            waitHandles.push_back(stateEvent);
+            waitHandles.push_back(transport.connectOverlapped.hEvent);
+            for (size_t i = 0; i < server.subscriberCount(); i++) {
+                waitHandles.push_back(server.subscriber(i).connection.writeOverlapped.hEvent);
+                waitHandles.push_back(server.subscriber(i).connection.readOverlapped.hEvent);
+            }
+
+            DWORD result = WaitForMultipleObjects(static_cast<DWORD>(waitHandles.size()),
+                waitHandles.data(), FALSE, INFINITE);
+            if (result == WAIT_FAILED || result == WAIT_OBJECT_0) {
+                break;
+            }
+
+            size_t index = result - WAIT_OBJECT_0;
+            if (index == 1) {
+                server.stateChanged();
+            }
+            else if (index == 2) {
+                ResetEvent(transport.connectOverlapped.hEvent);
+                server.connectCompleted();
+            }
+            else if (index < waitHandles.size()) {
+                size_t subscriberIndex = (index - 3) / 2;
+                auto& connection = server.subscriber(subscriberIndex).connection;
+                if ((index - 3) % 2 == 0) {
+                    server.writeCompleted(subscriberIndex, transport.finishWrite(connection));
+                }
+                else {
+                    server.readCompleted(subscriberIndex, transport.finishRead(connection));
+                }
+            }
+
+            server.removeDisconnected();
+        }
+
+        server.shutdown();
+        LogMessage("State subscriber pipe stopped");
+    }
+
+    void closeEvents() {
+        if (stopEvent) {
+            CloseHandle(stopEvent);
+            stopEvent = nullptr;
+        }
+        if (stateEvent) {
+            CloseHandle(stateEvent);
+            stateEvent = nullptr;
+        }
+        if (transport.connectOverlapped.hEvent) {
+            CloseHandle(transport.connectOverlapped.hEvent);
+            transport.connectOverlapped.hEvent = nullptr;
+        }
+    }
+};
+
 // Global instances
 MicrophoneMonitor g_monitor;
 ArduinoBLEController g_bleController;
+StateBroadcaster g_broadcaster;
 
 // Window procedure
 LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
@@ -649,6 +1388,13 @@ LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             LogMessage("Manual reconnection requested");
             g_bleController.forceReconnect();
             break;
+        case ID_TRAY_TOGGLE_TRACING:
+            g_tracer.setEnabled(!g_tracer.isEnabled());
+            LogMessage(g_tracer.isEnabled() ? "Tracing enabled" : "Tracing disabled");
+            break;
+        case ID_TRAY_EXPORT_TRACE:
+            ExportTrace();
+            break;
         case ID_TRAY_ABOUT:
             MessageBox(hWnd, L"Microphone LED Monitor v1.2\n\nMonitors microphone usage and controls Arduino LED via Bluetooth LE.\n\nDouble-click tray icon to show/hide console.\nClose button on console is disabled - use tray menu to hide.", L"About", MB_OK | MB_ICONINFORMATION);
             break;
@@ -675,15 +1421,21 @@ LRESULT CALLBACK WindowProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
 void monitorThread() {
     LogMessage("Starting microphone monitoring...");
 
-    bool lastMicState = false;
+    MicState lastMicState = MicState::Idle;
+    MicState lastTrayMicState = MicState::Idle;
     bool lastConnectedState = false;
     bool forceStateUpdate = false;
     auto lastStatusUpdate = std::chrono::steady_clock::now();
-    const auto STATUS_UPDATE_INTERVAL = std::chrono::seconds(30);
 
     while (!g_shouldExit) {
+        // One snapshot per tick - a hot reload takes effect on the next one
+        auto config = g_config.get();
+
         try {
+            TraceSpan tickSpan(g_tracer, "monitor tick");
+
             // Check connection status
+            g_bleController.updateKeepWarm();
             bool connected = g_bleController.getConnectionStatus();
 
             // Attempt reconnection if needed
@@ -696,13 +1448,16 @@ void monitorThread() {
             }
 
             // Check microphone status
-            bool micInUse = g_monitor.isMicrophoneInUse();
+            TraceSpan micSpan(g_tracer, "getMicrophoneState");
+            MicState micState = g_monitor.getMicrophoneState();
+            micSpan.end();
 
             // Update LED state if microphone state changed, we're connected, or force update needed
-            if ((micInUse != lastMicState || forceStateUpdate) && connected) {
-                LogMessage(micInUse ? "Microphone ACTIVE - LED ON" : "Microphone INACTIVE - LED OFF");
-                if (g_bleController.setLEDState(micInUse)) {
-                    lastMicState = micInUse;
+            if ((micState != lastMicState || forceStateUpdate) && connected) {
+                LogMessage(micState == MicState::Live ? "Microphone ACTIVE - LED ON" :
+                    (micState == MicState::Muted ? "Microphone MUTED - LED MUTED" : "Microphone INACTIVE - LED OFF"));
+                if (g_bleController.setLEDState(micState)) {
+                    lastMicState = micState;
                     forceStateUpdate = false;
                 }
                 else {
@@ -711,6 +1466,12 @@ void monitorThread() {
                 }
             }
 
+            // Refresh the tooltip on connection or mic changes (including mute toggles)
+            if (connected != lastConnectedState || micState != lastTrayMicState) {
+                UpdateTrayIcon(connected, micState);
+                lastTrayMicState = micState;
+            }
+
             // Handle connection state changes
             if (connected != lastConnectedState) {
                 if (connected) {
@@ -720,15 +1481,18 @@ void monitorThread() {
                 else {
                     LogMessage("Arduino disconnected - will attempt reconnection");
                 }
-                UpdateTrayIcon(connected, micInUse);
                 lastConnectedState = connected;
             }
 
+            // Push the current state to local subscribers
+            g_broadcaster.publish({ connected, micState, lastMicState });
+
             // Periodic status update
             auto now = std::chrono::steady_clock::now();
-            if (now - lastStatusUpdate >= STATUS_UPDATE_INTERVAL) {
+            if (now - lastStatusUpdate >= config->statusUpdateInterval) {
                 LogMessage("Status: " + std::string(connected ? "Connected" : "Disconnected") +
-                    ", Mic: " + std::string(micInUse ? "Active" : "Inactive"));
+                    ", Mic: " + std::string(micStateName(micState)));
+                LogMessage(g_bleController.getReconnectSummary());
                 lastStatusUpdate = now;
             }
 
@@ -740,8 +1504,8 @@ void monitorThread() {
             LogMessage("Unknown monitor thread error");
         }
 
-        // Sleep for 1 second
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        // Sleep for the profile's interval, waking early on mute/volume changes
+        g_monitor.waitForChange(config->monitorInterval);
     }
 
     LogMessage("Monitoring stopped");
@@ -755,6 +1519,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
         return 1;
     }
 
+    // Start with tracing on to capture the initial connection
+    if (lpCmdLine && strstr(lpCmdLine, "--trace")) {
+        g_tracer.setEnabled(true);
+    }
+
     // Create window class
     WNDCLASS wc = {};
     wc.lpfnWndProc = WindowProc;
@@ -789,6 +1558,12 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     LogMessage("Microphone LED Monitor started");
     LogMessage("Double-click tray icon to show/hide console");
 
+    // Load runtime profile and watch for changes
+    g_config.start();
+
+    // Start local state subscriber pipe
+    g_broadcaster.start();
+
     // Start monitoring thread
     std::thread monitorThreadHandle(monitorThread);
 
@@ -804,6 +1579,12 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     if (monitorThreadHandle.joinable()) {
         monitorThreadHandle.join();
     }
+    g_broadcaster.stop();
+    g_config.stop();
+
+    if (g_tracer.isEnabled()) {
+        ExportTrace();
+    }
 
     RemoveTrayIcon();
     CleanupConsole();
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "KeepWarmPolicy.h"
+
+// Runtime tuning - defaults match the "balanced" profile
+struct RuntimeConfig {
+    std::string profile = "balanced";
+    std::chrono::milliseconds reconnectDelay{ 3000 };
+    std::chrono::milliseconds scanTimeout{ 8000 };
+    std::chrono::milliseconds monitorInterval{ 1000 };
+    std::chrono::milliseconds statusUpdateInterval{ 30000 };
+    int gattRetries = 3;
+    size_t maxLogMessages = 100;
+    KeepWarmPolicy keepWarm;
+};
+
+inline bool GetBuiltinProfile(const std::string& name, RuntimeConfig& config) {
+    config = RuntimeConfig();
+    config.profile = name;
+
+    if (name == "balanced") {
+        return true;
+    }
+    if (name == "low-latency") {
+        config.reconnectDelay = std::chrono::milliseconds(1000);
+        config.scanTimeout = std::chrono::milliseconds(10000);
+        config.monitorInterval = std::chrono::milliseconds(250);
+        config.gattRetries = 5;
+        config.keepWarm = { 0, 24, false };
+        return true;
+    }
+    if (name == "low-power") {
+        config.reconnectDelay = std::chrono::milliseconds(10000);
+        config.scanTimeout = std::chrono::milliseconds(5000);
+        config.monitorInterval = std::chrono::milliseconds(2000);
+        config.statusUpdateInterval = std::chrono::milliseconds(120000);
+        config.gattRetries = 2;
+        config.maxLogMessages = 50;
+        config.keepWarm = { 0, 0, true };
+        return true;
+    }
+    return false;
+}
+
+inline std::string TrimConfigToken(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+// Parses an INI-style profile file:
+//   profile = low-latency
+//   [low-latency]
+//   monitor_interval_ms = 100
+// The selected profile starts from its built-in values (or "balanced" for a custom
+// name) and the matching section overrides individual settings.
+inline bool ParseRuntimeConfig(std::istream& in, RuntimeConfig& config, std::string& error) {
+    struct Entry {
+        std::string section;
+        std::string key;
+        std::string value;
+        int line;
+    };
+
+    std::vector<Entry> entries;
+    std::string profileName = "balanced";
+    std::string section;
+    std::string text;
+    int lineNumber = 0;
+
+    while (std::getline(in, text)) {
+        lineNumber++;
+        text = TrimConfigToken(text);
+        if (text.empty() || text[0] == '#' || text[0] == ';') {
+            continue;
+        }
+
+        if (text.front() == '[' && text.back() == ']') {
+            section = TrimConfigToken(text.substr(1, text.size() - 2));
+            continue;
+        }
+
+        size_t separator = text.find('=');
+        if (separator == std::string::npos) {
+            error = "line " + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+
+        std::string key = TrimConfigToken(text.substr(0, separator));
+        std::string value = TrimConfigToken(text.substr(separator + 1));
+        if (section.empty() && key == "profile") {
+            profileName = value;
+        }
+        else {
+            entries.push_back({ section, key, value, lineNumber });
+        }
+    }
+
+    bool hasSection = std::any_of(entries.begin(), entries.end(),
+        [&](const Entry& entry) { return entry.section == profileName; });
+    if (!GetBuiltinProfile(profileName, config)) {
+        if (!hasSection) {
+            error = "unknown profile '" + profileName + "'";
+            return false;
+        }
+        GetBuiltinProfile("balanced", config);
+        config.profile = profileName;
+    }
+
+    for (const auto& entry : entries) {
+        if (entry.section != profileName) {
+            continue;
+        }
+
+        long long value = 0;
+        try {
+            size_t consumed = 0;
+            value = std::stoll(entry.value, &consumed);
+            if (consumed != entry.value.size()) {
+                throw std::invalid_argument(entry.value);
+            }
+        }
+        catch (...) {
+            error = "line " + std::to_string(entry.line) + ": '" + entry.value + "' is not a number";
+            return false;
+        }
+
+        auto inRange = [&](long long minValue, long long maxValue) {
+            if (value < minValue || value > maxValue) {
+                error = "line " + std::to_string(entry.line) + ": " + entry.key + " must be between " +
+                    std::to_string(minValue) + " and " + std::to_string(maxValue);
+                return false;
+            }
+            return true;
+        };
+
+        if (entry.key == "reconnect_delay_ms") {
+            if (!inRange(100, 600000)) return false;
+            config.reconnectDelay = std::chrono::milliseconds(value);
+        }
+        else if (entry.key == "scan_timeout_ms") {
+            if (!inRange(1000, 60000)) return false;
+            config.scanTimeout = std::chrono::milliseconds(value);
+        }
+        else if (entry.key == "monitor_interval_ms") {
+            if (!inRange(50, 10000)) return false;
+            config.monitorInterval = std::chrono::milliseconds(value);
+        }
+        else if (entry.key == "status_update_interval_ms") {
+            if (!inRange(1000, 3600000)) return false;
+            config.statusUpdateInterval = std::chrono::milliseconds(value);
+        }
+        else if (entry.key == "gatt_retries") {
+            if (!inRange(1, 10)) return false;
+            config.gattRetries = static_cast<int>(value);
+        }
+        else if (entry.key == "max_log_messages") {
+            if (!inRange(10, 10000)) return false;
+            config.maxLogMessages = static_cast<size_t>(value);
+        }
+        else if (entry.key == "keep_warm_start_hour") {
+            if (!inRange(0, 24)) return false;
+            config.keepWarm.startHour = static_cast<int>(value);
+        }
+        else if (entry.key == "keep_warm_end_hour") {
+            if (!inRange(0, 24)) return false;
+            config.keepWarm.endHour = static_cast<int>(value);
+        }
+        else if (entry.key == "keep_warm_weekdays_only") {
+            if (!inRange(0, 1)) return false;
+            config.keepWarm.weekdaysOnly = value != 0;
+        }
+        else {
+            error = "line " + std::to_string(entry.line) + ": unknown setting '" + entry.key + "'";
+            return false;
+        }
+    }
+
+    // start > end is an overnight window; start == end only makes sense as "never"
+    if (config.keepWarm.startHour == 24 || (config.keepWarm.startHour == config.keepWarm.endHour &&
+        config.keepWarm.startHour != 0)) {
+        error = "keep_warm_start_hour must differ from keep_warm_end_hour and be below 24 (use 0 and 0 to disable)";
+        return false;
+    }
+
+    return true;
+}
+
+// Holds the current immutable config snapshot. Readers copy the shared_ptr under a
+// short lock; parsing and validation happen before the lock, so a reload never
+// stalls the monitor or controller, and a bad file leaves the previous snapshot.
+class RuntimeConfigStore {
+public:
+    std::shared_ptr<const RuntimeConfig> get() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return current;
+    }
+
+    // Parses and publishes; on error the previous snapshot stays current
+    bool apply(std::istream& in, std::string& error) {
+        auto config = std::make_shared<RuntimeConfig>();
+        if (!ParseRuntimeConfig(in, *config, error)) {
+            return false;
+        }
+        publish(std::move(config));
+        return true;
+    }
+
+    // Back to the built-in balanced profile, e.g. when the file is deleted
+    void reset() {
+        publish(std::make_shared<RuntimeConfig>());
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::shared_ptr<const RuntimeConfig> current = std::make_shared<const RuntimeConfig>();
+
+    void publish(std::shared_ptr<const RuntimeConfig> config) {
+        std::lock_guard<std::mutex> lock(mutex);
+        current.swap(config);
+        // The previous snapshot is released outside the lock when config goes out of scope
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// First-match claim shared between the advertisement callback and the scanning
+// thread. The platform filter has already matched service UUID and RSSI, so the
+// callback only has to claim an address: no allocation, and once a device is
+// found later callbacks return after a single relaxed load.
+class ScanMatch {
+public:
+    // Returns true for exactly one caller - the one whose address was recorded
+    bool claim(uint64_t candidate) noexcept {
+        if (candidate == 0 || address.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+        uint64_t expected = 0;
+        return address.compare_exchange_strong(expected, candidate, std::memory_order_acq_rel);
+    }
+
+    bool found() const noexcept {
+        return address.load(std::memory_order_acquire) != 0;
+    }
+
+    // Zero is never a valid Bluetooth address
+    uint64_t matchedAddress() const noexcept {
+        return address.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<uint64_t> address{ 0 };
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Span tracing - per-thread ring buffers exported as Chrome trace-event JSON.
+// When tracing is off a span costs one relaxed atomic load.
+struct TraceEvent {
+    const char* name; // Must point at a string literal
+    int64_t startUs;
+    int64_t durationUs;
+};
+
+struct TraceBuffer {
+    TraceBuffer(uint32_t threadId, size_t capacity) : threadId(threadId), events(capacity) {}
+
+    uint32_t threadId;
+    std::mutex mutex; // Only contended while exporting
+    std::vector<TraceEvent> events;
+    size_t next = 0;
+    bool wrapped = false;
+};
+
+class Tracer {
+public:
+    explicit Tracer(size_t capacityPerThread = 4096) : capacity(capacityPerThread), id(nextTracerId()++) {}
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void setEnabled(bool value) {
+        enabled.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t nowUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    void record(const char* name, int64_t startUs, int64_t durationUs) {
+        TraceBuffer& buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.events[buffer.next] = { name, startUs, durationUs };
+        buffer.next = (buffer.next + 1) % buffer.events.size();
+        buffer.wrapped = buffer.wrapped || buffer.next == 0;
+    }
+
+    // Writes every buffered span, oldest first per thread; returns the event count
+    size_t exportChromeTrace(std::ostream& out, uint32_t processId) {
+        size_t eventCount = 0;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        std::lock_guard<std::mutex> registryLock(registryMutex);
+        for (const auto& buffer : buffers) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            size_t size = buffer->events.size();
+            size_t count = buffer->wrapped ? size : buffer->next;
+            size_t first = buffer->wrapped ? buffer->next : 0;
+            for (size_t i = 0; i < count; i++) {
+                const TraceEvent& event = buffer->events[(first + i) % size];
+                out << (eventCount++ ? ",\n" : "\n")
+                    << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"ts\":" << event.startUs
+                    << ",\"dur\":" << event.durationUs << ",\"pid\":" << processId
+                    << ",\"tid\":" << buffer->threadId << "}";
+            }
+        }
+
+        out << "\n]}\n";
+        return eventCount;
+    }
+
+private:
+    const size_t capacity;
+    const uint64_t id;
+    std::atomic<bool> enabled{ false };
+    std::mutex registryMutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers; // Kept alive after their thread exits
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    static std::atomic<uint64_t>& nextTracerId() {
+        static std::atomic<uint64_t> value{ 1 };
+        return value;
+    }
+
+    static uint32_t currentThreadId() {
+        static std::atomic<uint32_t> nextThreadId{ 1 };
+        thread_local uint32_t threadId = nextThreadId++;
+        return threadId;
+    }
+
+    TraceBuffer& threadBuffer() {
+        // Cached per thread; the tracer id guards against a different Tracer instance
+        thread_local uint64_t cachedTracer = 0;
+        thread_local std::shared_ptr<TraceBuffer> cachedBuffer;
+        if (cachedTracer != id || !cachedBuffer) {
+            cachedBuffer = std::make_shared<TraceBuffer>(currentThreadId(), capacity);
+            cachedTracer = id;
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffers.push_back(cachedBuffer);
+        }
+        return *cachedBuffer;
+    }
+};
+
+// Records the enclosing scope as a span; end() closes it early
+class TraceSpan {
+public:
+    TraceSpan(Tracer& tracer, const char* name) : tracer(tracer), name(name), active(tracer.isEnabled()) {
+        if (active) {
+            startUs = tracer.nowUs();
+        }
+    }
+
+    ~TraceSpan() {
+        end();
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void end() {
+        if (active) {
+            tracer.record(name, startUs, tracer.nowUs() - startUs);
+            active = false;
+        }
+    }
+
+private:
+    Tracer& tracer;
+    const char* name;
+    int64_t startUs = 0;
+    bool active;
+};
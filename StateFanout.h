@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "MicState.h"
+
+// Snapshot of the state published to local subscribers
+struct MonitorSnapshot {
+    bool connected = false;
+    MicState micState = MicState::Idle;
+    MicState ledState = MicState::Idle;
+
+    bool operator==(const MonitorSnapshot& other) const {
+        return connected == other.connected && micState == other.micState && ledState == other.ledState;
+    }
+};
+
+// One JSON object per line
+inline std::string formatSnapshot(const MonitorSnapshot& snapshot, uint64_t sequence) {
+    std::ostringstream oss;
+    oss << "{\"seq\":" << sequence
+        << ",\"connected\":" << (snapshot.connected ? "true" : "false")
+        << ",\"mic\":\"" << micStateName(snapshot.micState) << "\""
+        << ",\"led\":\"" << (snapshot.connected ? micStateName(snapshot.ledState) : "off") << "\""
+        << "}\n";
+    return oss.str();
+}
+
+// Transport-independent fan-out bookkeeping for the state broadcaster. The producer
+// only swaps in the latest snapshot; the server thread asks for the next message per
+// subscriber whenever that subscriber has no write in flight. A subscriber that falls
+// behind skips intermediate states and receives the newest one, so a slow reader
+// costs one buffered message and never blocks the producer.
+class StateFanout {
+public:
+    // Per-subscriber progress, owned by the transport next to its connection
+    struct Cursor {
+        uint64_t sentSequence = 0;
+        bool writePending = false;
+    };
+
+    // Safe to call from any thread; returns false when nothing changed
+    bool publish(const MonitorSnapshot& snapshot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (sequence != 0 && snapshot == latest) {
+            return false;
+        }
+        latest = snapshot;
+        sequence++;
+        return true;
+    }
+
+    // Fills message and marks the write in flight if the subscriber is idle and behind
+    bool nextWrite(Cursor& cursor, std::string& message) {
+        if (cursor.writePending) {
+            return false;
+        }
+
+        MonitorSnapshot snapshot;
+        uint64_t snapshotSequence;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            snapshot = latest;
+            snapshotSequence = sequence;
+        }
+
+        if (snapshotSequence == 0 || snapshotSequence == cursor.sentSequence) {
+            return false;
+        }
+
+        message = formatSnapshot(snapshot, snapshotSequence);
+        cursor.sentSequence = snapshotSequence;
+        cursor.writePending = true;
+        return true;
+    }
+
+    void writeCompleted(Cursor& cursor) {
+        cursor.writePending = false;
+    }
+
+    uint64_t currentSequence() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sequence;
+    }
+
+private:
+    std::mutex mutex;
+    MonitorSnapshot latest;
+    uint64_t sequence = 0;
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "StateFanout.h"
+
+// Result of asking the transport to accept the next subscriber
+enum class ListenResult {
+    Pending,   // Waiting; the transport reports the connect through connectCompleted()
+    Connected, // A client was already waiting - there is no pending operation to complete
+    Failed
+};
+
+// Transport-independent subscriber lifecycle for the state broadcaster: accepting,
+// one write in flight per subscriber (what to send comes from StateFanout), one read
+// kept posted so a departed client is noticed without waiting for a state change,
+// closing, and listening again when a slot frees up. The transport owns the OS
+// handles and the wait loop and reports each completion back.
+//
+// Transport interface:
+//   using Connection = ...;                              // Per-subscriber OS state
+//   ListenResult listen();                               // Start accepting the next client
+//   void cancelListen();                                 // Abandon a pending listen
+//   bool accept(Connection&, bool synchronous);          // Take the accepted client
+//   bool beginWrite(Connection&, const std::string&);    // false if the write failed at once
+//   bool beginRead(Connection&);                         // false if the client has already gone
+//   void close(Connection&, bool writePending, bool readPending);
+//   void release(Connection&);                           // Once out of the wait set
+//   void log(const std::string&);
+template <typename Transport>
+class SubscriberServer {
+public:
+    struct Subscriber {
+        typename Transport::Connection connection;
+        std::string buffer; // Owned by the in-flight write
+        StateFanout::Cursor cursor;
+        bool readPending = false;
+        bool open = true;
+    };
+
+    SubscriberServer(Transport& transport, StateFanout& fanout, size_t maxSubscribers)
+        : transport(transport), fanout(fanout), maxSubscribers(maxSubscribers) {}
+
+    void start() {
+        beginListen();
+    }
+
+    // The fan-out has a newer snapshot
+    void stateChanged() {
+        for (auto& subscriber : subscribers) {
+            sendLatest(*subscriber);
+        }
+    }
+
+    // A pending listen finished (successfully or not)
+    void connectCompleted() {
+        if (!listening) {
+            return;
+        }
+        acceptSubscriber(false);
+        beginListen();
+    }
+
+    void writeCompleted(size_t index, bool ok) {
+        Subscriber& subscriber = *subscribers[index];
+        fanout.writeCompleted(subscriber.cursor);
+        if (!ok) {
+            closeSubscriber(subscriber);
+            return;
+        }
+        // Catch up with anything published while this write was in flight
+        sendLatest(subscriber);
+    }
+
+    void readCompleted(size_t index, bool ok) {
+        Subscriber& subscriber = *subscribers[index];
+        subscriber.readPending = false;
+        if (!ok) {
+            closeSubscriber(subscriber);
+            return;
+        }
+        postRead(subscriber); // Client input is ignored
+    }
+
+    // Drops closed subscribers; call once the transport no longer waits on them
+    void removeDisconnected() {
+        size_t before = subscribers.size();
+        for (auto it = subscribers.begin(); it != subscribers.end();) {
+            if ((*it)->open) {
+                ++it;
+                continue;
+            }
+            transport.release((*it)->connection);
+            it = subscribers.erase(it);
+        }
+
+        if (subscribers.size() != before) {
+            transport.log("State subscriber disconnected (" + std::to_string(subscribers.size()) + " remaining)");
+            if (!listening) {
+                beginListen();
+            }
+        }
+    }
+
+    void shutdown() {
+        if (listening) {
+            transport.cancelListen();
+            listening = false;
+        }
+        for (auto& subscriber : subscribers) {
+            closeSubscriber(*subscriber);
+        }
+        removeDisconnected();
+    }
+
+    size_t subscriberCount() const {
+        return subscribers.size();
+    }
+
+    Subscriber& subscriber(size_t index) {
+        return *subscribers[index];
+    }
+
+    bool isListening() const {
+        return listening;
+    }
+
+private:
+    Transport& transport;
+    StateFanout& fanout;
+    size_t maxSubscribers;
+    bool listening = false;
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+
+    void beginListen() {
+        while (!listening && subscribers.size() < maxSubscribers) {
+            switch (transport.listen()) {
+            case ListenResult::Pending:
+                listening = true;
+                return;
+            case ListenResult::Connected:
+                // Take it now and listen again for the next one
+                listening = true;
+                acceptSubscriber(true);
+                break;
+            case ListenResult::Failed:
+                return;
+            }
+        }
+    }
+
+    void acceptSubscriber(bool synchronous) {
+        listening = false;
+        auto subscriber = std::make_unique<Subscriber>();
+        if (!transport.accept(subscriber->connection, synchronous)) {
+            return;
+        }
+
+        subscribers.push_back(std::move(subscriber));
+        transport.log("State subscriber connected (" + std::to_string(subscribers.size()) + " total)");
+        // New subscribers get the current snapshot immediately
+        postRead(*subscribers.back());
+        sendLatest(*subscribers.back());
+    }
+
+    void sendLatest(Subscriber& subscriber) {
+        if (!subscriber.open || !fanout.nextWrite(subscriber.cursor, subscriber.buffer)) {
+            return;
+        }
+        if (!transport.beginWrite(subscriber.connection, subscriber.buffer)) {
+            fanout.writeCompleted(subscriber.cursor);
+            closeSubscriber(subscriber);
+        }
+    }
+
+    void postRead(Subscriber& subscriber) {
+        if (!subscriber.open) {
+            return;
+        }
+        if (transport.beginRead(subscriber.connection)) {
+            subscriber.readPending = true;
+        }
+        else {
+            closeSubscriber(subscriber);
+        }
+    }
+
+    void closeSubscriber(Subscriber& subscriber) {
+        if (!subscriber.open) {
+            return;
+        }
+        // Outstanding I/O is finished by the transport before its buffers are released
+        transport.close(subscriber.connection, subscriber.cursor.writePending, subscriber.readPending);
+        if (subscriber.cursor.writePending) {
+            fanout.writeCompleted(subscriber.cursor);
+        }
+        subscriber.readPending = false;
+        subscriber.open = false;
+    }
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+// Multi-host LED state tracking, kept free of Arduino types so it also builds in
+// the host-side tests. Callers pass the central's address and the current time.
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Values written to the switch characteristic
+const uint8_t LED_STATE_OFF = 0;
+const uint8_t LED_STATE_LIVE = 1;
+const uint8_t LED_STATE_MUTED = 2;
+
+#define MAX_HOSTS 3  // ArduinoBLE's ATT layer supports a small number of peers
+const unsigned long HOST_STALE_TIMEOUT = 5000; // Keep a dropped host's state briefly in case it reconnects
+const size_t HOST_ADDRESS_LENGTH = 18; // "aa:bb:cc:dd:ee:ff" plus terminator
+
+struct HostState {
+  bool inUse;
+  bool connected;
+  char address[HOST_ADDRESS_LENGTH];
+  uint8_t state;
+  unsigned long lastSeen;
+};
+
+class HostTable {
+public:
+  HostState hosts[MAX_HOSTS] = {};
+
+  // Returns the slot for this central, claiming a free (or the stalest disconnected) slot if needed
+  HostState* find(const char* address, bool create, unsigned long now) {
+    for (int i = 0; i < MAX_HOSTS; i++) {
+      if (hosts[i].inUse && strncmp(hosts[i].address, address, HOST_ADDRESS_LENGTH) == 0) {
+        return &hosts[i];
+      }
+    }
+    
+    if (!create) {
+      return nullptr;
+    }
+    
+    HostState* freeSlot = nullptr;
+    for (int i = 0; i < MAX_HOSTS && !freeSlot; i++) {
+      if (!hosts[i].inUse) {
+        freeSlot = &hosts[i];
+      }
+    }
+    if (!freeSlot) {
+      for (int i = 0; i < MAX_HOSTS; i++) {
+        if (!hosts[i].connected && (!freeSlot || hosts[i].lastSeen < freeSlot->lastSeen)) {
+          freeSlot = &hosts[i];
+        }
+      }
+    }
+    
+    if (!freeSlot) {
+      return nullptr;
+    }
+    
+    freeSlot->inUse = true;
+    freeSlot->connected = false;
+    strncpy(freeSlot->address, address, HOST_ADDRESS_LENGTH - 1);
+    freeSlot->address[HOST_ADDRESS_LENGTH - 1] = '\0';
+    freeSlot->state = LED_STATE_OFF;
+    freeSlot->lastSeen = now;
+    return freeSlot;
+  }
+
+  void connected(const char* address, unsigned long now) {
+    HostState* host = find(address, true, now);
+    if (host) {
+      host->connected = true;
+      host->lastSeen = now;
+    }
+  }
+
+  // Keeps the host's state until HOST_STALE_TIMEOUT so a brief drop doesn't flicker the LED
+  void disconnected(const char* address, unsigned long now) {
+    HostState* host = find(address, false, now);
+    if (host) {
+      host->connected = false;
+      host->lastSeen = now;
+    }
+  }
+
+  void written(const char* address, uint8_t newState, unsigned long now) {
+    if (newState > LED_STATE_MUTED) {
+      newState = LED_STATE_LIVE;  // Older hosts may write any non-zero value for "on"
+    }
+    
+    HostState* host = find(address, true, now);
+    if (host) {
+      host->connected = true;
+      host->state = newState;
+      host->lastSeen = now;
+    }
+  }
+
+  // Drops hosts that disconnected and did not come back within HOST_STALE_TIMEOUT.
+  // onExpired (optional) sees each host before its slot is cleared.
+  int expire(unsigned long now, void (*onExpired)(const HostState&) = nullptr) {
+    int expired = 0;
+    for (int i = 0; i < MAX_HOSTS; i++) {
+      if (hosts[i].inUse && !hosts[i].connected && now - hosts[i].lastSeen > HOST_STALE_TIMEOUT) {
+        if (onExpired) {
+          onExpired(hosts[i]);
+        }
+        hosts[i].inUse = false;
+        hosts[i].address[0] = '\0';
+        expired++;
+      }
+    }
+    return expired;
+  }
+
+  // Live on any host wins over muted, muted wins over off
+  uint8_t aggregate() const {
+    uint8_t aggregate = LED_STATE_OFF;
+    for (int i = 0; i < MAX_HOSTS; i++) {
+      if (!hosts[i].inUse) {
+        continue;
+      }
+      if (hosts[i].state == LED_STATE_LIVE) {
+        return LED_STATE_LIVE;
+      }
+      if (hosts[i].state == LED_STATE_MUTED) {
+        aggregate = LED_STATE_MUTED;
+      }
+    }
+    return aggregate;
+  }
+
+  int connectedCount() const {
+    int count = 0;
+    for (int i = 0; i < MAX_HOSTS; i++) {
+      if (hosts[i].inUse && hosts[i].connected) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  // True while any host is connected or still inside its reconnect grace period
+  bool anyInUse() const {
+    for (int i = 0; i < MAX_HOSTS; i++) {
+      if (hosts[i].inUse) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
@@ -17,11 +17,13 @@
 #include <esp_wifi.h>
 #include <esp_bt.h>
 #include <FastLED.h>  // Include FastLED library
+#include "HostTable.h"
 #define NUM_LEDS 8    // Number of LEDs in the chain
 #define DATA_PIN 23    // Data pin for LED control
 
 CRGB leds[NUM_LEDS];  // Array to hold LED color data
 CRGB ledColor = CRGB::Red;
+CRGB mutedColor = CRGB::Orange;  // Mic held open but muted on the host
 
 BLEService ledService("19B10000-E8F2-537E-4F6C-D104768A1214");
 BLEByteCharacteristic switchCharacteristic("19B10001-E8F2-537E-4F6C-D104768A1214", BLERead | BLEWrite);
@@ -33,8 +35,12 @@ const unsigned long IDLE_TIMEOUT = 300000; // 5 minutes before deep sleep
 const unsigned long CONNECTION_TIMEOUT = 60000; // 1 minute without connection
 const uint32_t sleepTimeMs = 100; // light sleep for 100 ms
 const uint32_t deepSleepTimeSec = 30; // deep sleep for 30 seconds
-bool deviceConnected = false;
-bool ledState = false;
+bool deviceConnected = false;  // True while any host is connected
+uint8_t ledState = LED_STATE_OFF;
+
+// Multi-host tracking - several computers can share one light. Each connected
+// central reports its own mic state and the LED shows the OR of all hosts.
+HostTable hostTable;
 
 // Power management configuration
 void configurePowerManagement() {
@@ -104,6 +110,11 @@ void setup() {
   // Set the initial value for the characteristic
   switchCharacteristic.writeValue(0);
   
+  // Event handlers let every connected host write without waiting on the others
+  BLE.setEventHandler(BLEConnected, onCentralConnected);
+  BLE.setEventHandler(BLEDisconnected, onCentralDisconnected);
+  switchCharacteristic.setEventHandler(BLEWritten, onSwitchWritten);
+  
   // Start advertising
   BLE.advertise();
   
@@ -142,35 +153,91 @@ void enterLightSleep() {
   esp_light_sleep_start();
 }
 
-void handleLEDControl() {
-  if (switchCharacteristic.written()) {
-    lastActivityTime = millis(); // Reset activity timer
-    
-    bool newState = switchCharacteristic.value() != 0;
-    
-    if (newState != ledState) {
-      ledState = newState;
-      
-      if (ledState) {
-        Serial.println("LED on");
-        // Loop through each LED and turn it on
-        for (int dot = 0; dot < NUM_LEDS; dot++) {
-          leds[dot] = ledColor;   // Set the current LED to blue
-        }
-        FastLED.show();           // Update LEDs
-      } else {
-        Serial.println("LED off");
-        // Loop through each LED and turn it off
-        for (int dot = 0; dot < NUM_LEDS; dot++) {
-          leds[dot] = CRGB::Black;   // Set the current LED to blue
-        }
-        FastLED.show();           // Update LEDs
-      }
+void showLEDState(uint8_t newState) {
+  if (newState == ledState) {
+    return;
+  }
+  ledState = newState;
+  
+  if (ledState != LED_STATE_OFF) {
+    Serial.println(ledState == LED_STATE_MUTED ? "LED muted" : "LED on");
+    // Loop through each LED and turn it on
+    for (int dot = 0; dot < NUM_LEDS; dot++) {
+      leds[dot] = ledState == LED_STATE_MUTED ? mutedColor : ledColor;
+    }
+    FastLED.show();           // Update LEDs
+  } else {
+    Serial.println("LED off");
+    // Loop through each LED and turn it off
+    for (int dot = 0; dot < NUM_LEDS; dot++) {
+      leds[dot] = CRGB::Black;
+    }
+    FastLED.show();           // Update LEDs
+  }
+}
+
+void updateAggregateLED() {
+  showLEDState(hostTable.aggregate());
+}
+
+void onCentralConnected(BLEDevice central) {
+  Serial.print("Connected to central: ");
+  Serial.println(central.address());
+  
+  hostTable.connected(central.address().c_str(), millis());
+  
+  deviceConnected = true;
+  lastActivityTime = millis();
+  lastConnectionTime = millis();
+  updateAggregateLED();
+  
+  // Advertising stops on connect - resume so other hosts can join
+  if (hostTable.connectedCount() < MAX_HOSTS) {
+    BLE.advertise();
+  }
+}
+
+void onCentralDisconnected(BLEDevice central) {
+  Serial.print("Disconnected from central: ");
+  Serial.println(central.address());
+  
+  hostTable.disconnected(central.address().c_str(), millis());
+  
+  deviceConnected = hostTable.connectedCount() > 0;
+  // A host that sat connected without writing must not send us straight to deep sleep
+  lastActivityTime = millis();
+  lastConnectionTime = millis();
+  BLE.advertise();
+}
+
+void onSwitchWritten(BLEDevice central, BLECharacteristic characteristic) {
+  lastActivityTime = millis(); // Reset activity timer
+  
+  hostTable.written(central.address().c_str(), switchCharacteristic.value(), millis());
+  updateAggregateLED();
+}
+
+void logExpiredHost(const HostState& host) {
+  Serial.print("Host timed out: ");
+  Serial.println(host.address);
+}
+
+void expireStaleHosts() {
+  if (hostTable.expire(millis(), logExpiredHost) > 0) {
+    updateAggregateLED();
+    // Turn off LED when every host is gone to save power
+    if (ledState == LED_STATE_OFF) {
+      switchCharacteristic.writeValue(LED_STATE_OFF);
     }
   }
 }
 
 void checkPowerManagement() {
+  // Never sleep while a host holds a connection or may still reconnect
+  if (deviceConnected || hostTable.anyInUse()) {
+    return;
+  }
+  
   unsigned long currentTime = millis();
   
   // Check for deep sleep condition (long inactivity)
@@ -180,7 +247,7 @@ void checkPowerManagement() {
   }
   
   // If not connected and no recent activity, enter light sleep briefly
-  if (!deviceConnected && (currentTime - lastConnectionTime > 10000)) {
+  if (currentTime - lastConnectionTime > 10000) {
     // Light sleep for 100ms when no device connected and idle
     enterLightSleep();
     lastConnectionTime = millis(); // Reset to prevent immediate re-sleep
@@ -188,51 +255,15 @@ void checkPowerManagement() {
 }
 
 void loop() {
-  // Listen for Bluetooth® Low Energy peripherals to connect
-  BLEDevice central = BLE.central();
-  
-  // If a central is connected to peripheral
-  if (central) {
-    if (!deviceConnected) {
-      Serial.print("Connected to central: ");
-      Serial.println(central.address());
-      deviceConnected = true;
-      lastActivityTime = millis();
-      lastConnectionTime = millis();
-    }
-    
-    // While the central is still connected to peripheral
-    while (central.connected()) {
-      handleLEDControl();
-      
-      // Brief delay to prevent busy-waiting and allow power management
-      delay(50); // Reduced from typical 100ms for better responsiveness
-      
-      // Update connection time
-      lastConnectionTime = millis();
-    }
-    
-    // When the central disconnects
-    Serial.print("Disconnected from central: ");
-    Serial.println(central.address());
-    deviceConnected = false;
+  // Service connections and writes from every host; returns early when an event arrives
+  BLE.poll(deviceConnected ? 50 : 500);
+  
+  if (deviceConnected) {
     lastConnectionTime = millis();
-    
-    // Turn off LED when disconnected to save power
-    // Loop through each LED and turn it off
-    for (int dot = 0; dot < NUM_LEDS; dot++) {
-      leds[dot] = CRGB::Black;   // Set the current LED to blue
-    }
-    FastLED.show();           // Update LEDs
-    ledState = false;
-    switchCharacteristic.writeValue(0);
   }
   
+  expireStaleHosts();
+  
   // Check if we should enter power saving mode
   checkPowerManagement();
-  
-  // Small delay to prevent busy loop when not connected
-  if (!deviceConnected) {
-    delay(500); // Longer delay when not connected
-  }
-}
\ No newline at end of file
+}
@@ -0,0 +1,172 @@
+// Drives the firmware's HostTable through a simulated BLE peripheral that several
+// centrals connect to, write and drop from - the same event order ArduinoBLE's
+// BLEConnected / BLEWritten / BLEDisconnected handlers deliver.
+#include "esp32_mic_sleep/HostTable.h"
+#include "TestSupport.h"
+
+#include <string>
+
+namespace {
+
+// Stand-in for the sketch: a clock, the host table and the LED it drives
+class SimulatedPeripheral {
+public:
+    unsigned long now = 1000;
+    HostTable table;
+    uint8_t led = LED_STATE_OFF;
+    int expired = 0;
+
+    void connect(const std::string& address) {
+        table.connected(address.c_str(), now);
+        led = table.aggregate();
+    }
+
+    void disconnect(const std::string& address) {
+        table.disconnected(address.c_str(), now);
+        led = table.aggregate();
+    }
+
+    void write(const std::string& address, uint8_t value) {
+        table.written(address.c_str(), value, now);
+        led = table.aggregate();
+    }
+
+    // One pass of loop() after `elapsed` milliseconds
+    void advance(unsigned long elapsed) {
+        now += elapsed;
+        expired += table.expire(now);
+        led = table.aggregate();
+    }
+
+    bool holdsSlot(const std::string& address) {
+        return table.find(address.c_str(), false, now) != nullptr;
+    }
+};
+
+const std::string HOST_A = "aa:aa:aa:aa:aa:01";
+const std::string HOST_B = "bb:bb:bb:bb:bb:02";
+const std::string HOST_C = "cc:cc:cc:cc:cc:03";
+const std::string HOST_D = "dd:dd:dd:dd:dd:04";
+
+void testOrAggregation() {
+    SimulatedPeripheral peripheral;
+    peripheral.connect(HOST_A);
+    peripheral.connect(HOST_B);
+    peripheral.connect(HOST_C);
+    CHECK_EQ(peripheral.table.connectedCount(), 3);
+    CHECK_EQ(peripheral.led, LED_STATE_OFF);
+
+    peripheral.write(HOST_A, LED_STATE_MUTED);
+    CHECK_EQ(peripheral.led, LED_STATE_MUTED);
+
+    // Live anywhere wins over muted elsewhere
+    peripheral.write(HOST_B, LED_STATE_LIVE);
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+    peripheral.write(HOST_C, LED_STATE_MUTED);
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+
+    // One host going idle does not turn off the others
+    peripheral.write(HOST_B, LED_STATE_OFF);
+    CHECK_EQ(peripheral.led, LED_STATE_MUTED);
+    peripheral.write(HOST_A, LED_STATE_OFF);
+    peripheral.write(HOST_C, LED_STATE_OFF);
+    CHECK_EQ(peripheral.led, LED_STATE_OFF);
+
+    // Older hosts write any non-zero value for "on"
+    peripheral.write(HOST_A, 0xFF);
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+    CHECK_EQ(peripheral.table.find(HOST_A.c_str(), false, peripheral.now)->state, LED_STATE_LIVE);
+}
+
+void testStaleExpiry() {
+    SimulatedPeripheral peripheral;
+    peripheral.connect(HOST_A);
+    peripheral.connect(HOST_B);
+    peripheral.write(HOST_A, LED_STATE_LIVE);
+    peripheral.write(HOST_B, LED_STATE_MUTED);
+
+    // A brief drop keeps the host's state and slot
+    peripheral.disconnect(HOST_A);
+    CHECK_EQ(peripheral.table.connectedCount(), 1);
+    peripheral.advance(HOST_STALE_TIMEOUT / 2);
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+    peripheral.connect(HOST_A);
+    peripheral.advance(HOST_STALE_TIMEOUT * 2);
+    CHECK_EQ(peripheral.expired, 0);
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+
+    // A host that stays away is dropped and no longer counts
+    peripheral.disconnect(HOST_A);
+    peripheral.advance(HOST_STALE_TIMEOUT);
+    CHECK(peripheral.holdsSlot(HOST_A)); // Not past the timeout yet
+    peripheral.advance(1);
+    CHECK_EQ(peripheral.expired, 1);
+    CHECK(!peripheral.holdsSlot(HOST_A));
+    CHECK_EQ(peripheral.led, LED_STATE_MUTED);
+
+    // Connected hosts never expire, however long they stay quiet
+    peripheral.advance(HOST_STALE_TIMEOUT * 100);
+    CHECK(peripheral.holdsSlot(HOST_B));
+
+    // The last host leaving keeps the table in use (no sleep) until it expires
+    peripheral.disconnect(HOST_B);
+    CHECK_EQ(peripheral.table.connectedCount(), 0);
+    CHECK(peripheral.table.anyInUse());
+    peripheral.advance(HOST_STALE_TIMEOUT + 1);
+    CHECK(!peripheral.table.anyInUse());
+    CHECK_EQ(peripheral.led, LED_STATE_OFF);
+}
+
+void testSlotEviction() {
+    SimulatedPeripheral peripheral;
+    peripheral.connect(HOST_A);
+    peripheral.connect(HOST_B);
+    peripheral.connect(HOST_C);
+    peripheral.write(HOST_A, LED_STATE_LIVE);
+    peripheral.write(HOST_B, LED_STATE_MUTED);
+
+    // Every slot connected - a fourth central gets no slot and cannot change the LED
+    peripheral.write(HOST_D, LED_STATE_OFF);
+    CHECK(!peripheral.holdsSlot(HOST_D));
+    CHECK_EQ(peripheral.led, LED_STATE_LIVE);
+
+    // Within the grace period the stalest disconnected host gives up its slot
+    peripheral.disconnect(HOST_A);
+    peripheral.advance(100);
+    peripheral.disconnect(HOST_B);
+    peripheral.advance(100);
+    peripheral.connect(HOST_D);
+    CHECK(peripheral.holdsSlot(HOST_D));
+    CHECK(!peripheral.holdsSlot(HOST_A));
+    CHECK(peripheral.holdsSlot(HOST_B));
+    CHECK(peripheral.holdsSlot(HOST_C));
+    CHECK_EQ(peripheral.table.connectedCount(), 2);
+    // A's live state left with its slot; B's muted state is still held
+    CHECK_EQ(peripheral.led, LED_STATE_MUTED);
+
+    // The new host starts off, not with the evicted host's state
+    CHECK_EQ(peripheral.table.find(HOST_D.c_str(), false, peripheral.now)->state, LED_STATE_OFF);
+}
+
+void testClockWrap() {
+    // millis() wraps after ~49 days; expiry uses unsigned differences
+    SimulatedPeripheral peripheral;
+    peripheral.now = static_cast<unsigned long>(-1000);
+    peripheral.connect(HOST_A);
+    peripheral.write(HOST_A, LED_STATE_LIVE);
+    peripheral.disconnect(HOST_A);
+    peripheral.advance(2000);
+    CHECK(peripheral.holdsSlot(HOST_A));
+    peripheral.advance(HOST_STALE_TIMEOUT);
+    CHECK(!peripheral.holdsSlot(HOST_A));
+}
+
+} // namespace
+
+int main() {
+    testOrAggregation();
+    testStaleExpiry();
+    testSlotEviction();
+    testClockWrap();
+    return testResult("HostTableTest");
+}
@@ -0,0 +1,25 @@
+#include "MicState.h"
+#include "TestSupport.h"
+
+#include <string>
+
+int main() {
+    // Idle regardless of mute
+    CHECK(combineMicState(false, false) == MicState::Idle);
+    CHECK(combineMicState(false, true) == MicState::Idle);
+
+    // Active session: mute decides between live and muted
+    CHECK(combineMicState(true, false) == MicState::Live);
+    CHECK(combineMicState(true, true) == MicState::Muted);
+
+    // Wire values understood by the firmware
+    CHECK_EQ(static_cast<int>(MicState::Idle), 0);
+    CHECK_EQ(static_cast<int>(MicState::Live), 1);
+    CHECK_EQ(static_cast<int>(MicState::Muted), 2);
+
+    CHECK_EQ(std::string(micStateName(MicState::Idle)), "idle");
+    CHECK_EQ(std::string(micStateName(MicState::Live)), "live");
+    CHECK_EQ(std::string(micStateName(MicState::Muted)), "muted");
+
+    return testResult("MicStateTest");
+}
@@ -0,0 +1,287 @@
+// Simulates a week of the monitor loop against a model BLE transport to compare
+// reconnect churn and cost with and without a kept-warm GATT session.
+//
+// The transport models what the Windows stack does to an unused link: it tears it
+// down after an idle period unless a GATT session maintains it. Random RF drops
+// happen either way; a maintained session usually restores the link in the
+// background after a few seconds, but sometimes never does. Each tick the loop
+// makes the controller's own decision (decideReconnect) about waiting, resuming
+// the session or paying a full scan + connect + GATT discovery.
+#include "KeepWarmPolicy.h"
+#include "TestSupport.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int SECONDS_PER_DAY = 24 * 60 * 60;
+const int SIMULATED_DAYS = 7;              // Monday through Sunday
+const int IDLE_TEARDOWN_SECONDS = 120;     // OS drops a link with no traffic
+const int RECONNECT_DELAY_SECONDS = 3;     // Balanced profile
+const int SCAN_TIMEOUT_SECONDS = 8;        // Balanced profile - also the session restore grace
+const double RF_DROPS_PER_HOUR = 0.25;
+const double SESSION_RESTORE_FAILURE_RATE = 0.2;
+const int NEVER = 1 << 30;
+
+struct Meeting {
+    int start;
+    int end;
+};
+
+struct SimulationResult {
+    ReconnectStats stats;
+    int osTeardowns = 0;
+    int keptWarmDrops = 0;      // RF drops while the session was maintaining the link
+    int fallbackReconnects = 0; // Full reconnects after the session failed to restore
+    int micOnEvents = 0;
+    int delayedMicOnEvents = 0;
+    long long micOnLatencyTotal = 0;
+    int micOnLatencyMax = 0;
+    long long linkUpSeconds = 0;
+};
+
+std::tm simulatedLocalTime(int t) {
+    std::tm tm = {};
+    int day = t / SECONDS_PER_DAY;
+    tm.tm_wday = (1 + day) % 7; // Day 0 is a Monday
+    tm.tm_hour = (t % SECONDS_PER_DAY) / 3600;
+    tm.tm_min = (t % 3600) / 60;
+    return tm;
+}
+
+std::vector<Meeting> makeMeetings(std::mt19937& random) {
+    std::vector<Meeting> meetings;
+    std::uniform_int_distribution<int> startOffset(9 * 3600, 17 * 3600);
+    std::uniform_int_distribution<int> length(15 * 60, 60 * 60);
+    for (int day = 0; day < 5; day++) {
+        for (int i = 0; i < 6; i++) {
+            int start = day * SECONDS_PER_DAY + startOffset(random);
+            meetings.push_back({ start, start + length(random) });
+        }
+    }
+    std::sort(meetings.begin(), meetings.end(), [](const Meeting& a, const Meeting& b) { return a.start < b.start; });
+    return meetings;
+}
+
+std::vector<int> makeRfDrops(std::mt19937& random) {
+    std::vector<int> drops;
+    std::exponential_distribution<double> gap(RF_DROPS_PER_HOUR / 3600.0);
+    for (double t = gap(random); t < SIMULATED_DAYS * SECONDS_PER_DAY; t += gap(random)) {
+        drops.push_back(static_cast<int>(t));
+    }
+    return drops;
+}
+
+// Model transport: link state plus the costs of bringing it back
+class SimulatedBleTransport {
+public:
+    enum class Link { Down, Reconnecting, Restoring, Up };
+
+    explicit SimulatedBleTransport(unsigned seed) : random(seed) {}
+
+    Link link = Link::Down;
+    int readyAt = 0;
+    int lastTraffic = 0;
+
+    // Scan + FromBluetoothAddressAsync + GATT enumeration
+    int fullReconnectCost() {
+        std::uniform_int_distribution<int> scan(1, 4), connect(1, 2), discovery(1, 3);
+        return scan(random) + connect(random) + discovery(random);
+    }
+
+    // Background re-establishment by a maintained session; NEVER if it gives up
+    int sessionRestoreCost() {
+        std::uniform_real_distribution<double> failure(0.0, 1.0);
+        std::uniform_int_distribution<int> restore(1, 5);
+        int cost = restore(random);
+        return failure(random) < SESSION_RESTORE_FAILURE_RATE ? NEVER : cost;
+    }
+
+private:
+    std::mt19937 random;
+};
+
+std::chrono::milliseconds seconds(int count) {
+    return std::chrono::seconds(count);
+}
+
+SimulationResult simulate(bool useSession, int restoreGraceSeconds, const std::vector<Meeting>& meetings,
+    const std::vector<int>& rfDrops) {
+    KeepWarmPolicy policy;
+    SimulatedBleTransport transport(7);
+    SimulationResult result;
+
+    using Link = SimulatedBleTransport::Link;
+    int lastAttempt = -RECONNECT_DELAY_SECONDS;
+    int droppedAt = 0;
+    size_t nextDrop = 0;
+    bool micLive = false;
+    int pendingMicOnSince = -1;
+
+    for (int t = 0; t < SIMULATED_DAYS * SECONDS_PER_DAY; t++) {
+        bool keepWarm = useSession && policy.shouldKeepWarm(simulatedLocalTime(t));
+
+        // Mic schedule - every change is an LED write once the link is up
+        bool shouldBeLive = std::any_of(meetings.begin(), meetings.end(),
+            [t](const Meeting& meeting) { return t >= meeting.start && t < meeting.end; });
+        if (shouldBeLive != micLive) {
+            micLive = shouldBeLive;
+            if (micLive) {
+                result.micOnEvents++;
+                pendingMicOnSince = t;
+            }
+            if (transport.link == Link::Up) {
+                transport.lastTraffic = t;
+            }
+        }
+
+        bool rfDrop = nextDrop < rfDrops.size() && rfDrops[nextDrop] == t;
+        if (rfDrop) {
+            nextDrop++;
+        }
+
+        if (transport.link == Link::Up) {
+            if (rfDrop) {
+                result.stats.linkDrops++;
+                droppedAt = t;
+                if (keepWarm) {
+                    result.keptWarmDrops++;
+                    transport.link = Link::Restoring;
+                    transport.readyAt = t + transport.sessionRestoreCost();
+                }
+                else {
+                    transport.link = Link::Down;
+                }
+            }
+            else if (!keepWarm && t - transport.lastTraffic >= IDLE_TEARDOWN_SECONDS) {
+                result.osTeardowns++;
+                transport.link = Link::Down;
+            }
+        }
+        else if (transport.link == Link::Reconnecting) {
+            if (t >= transport.readyAt) {
+                result.stats.successes++;
+                transport.link = Link::Up;
+                transport.lastTraffic = t; // Forced LED state write after (re)connection
+            }
+        }
+
+        // The monitor tick that notices a drop also makes the reconnect decision
+        if (transport.link == Link::Down || transport.link == Link::Restoring) {
+            // The session stops maintaining the link outside the keep-warm window
+            bool sessionHeld = transport.link == Link::Restoring && keepWarm;
+            bool sessionLinkUp = sessionHeld && t >= transport.readyAt;
+            switch (decideReconnect(sessionHeld, sessionLinkUp, seconds(t - droppedAt), seconds(t - lastAttempt),
+                seconds(RECONNECT_DELAY_SECONDS), seconds(restoreGraceSeconds))) {
+            case ReconnectAction::ResumeSession:
+                result.stats.sessionResumes++;
+                transport.link = Link::Up;
+                transport.lastTraffic = t;
+                break;
+
+            case ReconnectAction::FullReconnect: {
+                if (transport.link == Link::Restoring) {
+                    result.fallbackReconnects++; // cleanupConnection() closes the session
+                }
+                lastAttempt = t;
+                result.stats.attempts++;
+                int cost = transport.fullReconnectCost();
+                transport.link = Link::Reconnecting;
+                transport.readyAt = t + cost;
+                result.stats.lastDuration = std::chrono::seconds(cost);
+                result.stats.totalDuration += std::chrono::seconds(cost);
+                break;
+            }
+
+            case ReconnectAction::Wait:
+                break;
+            }
+        }
+
+        if (transport.link == Link::Up) {
+            result.linkUpSeconds++;
+            if (pendingMicOnSince >= 0) {
+                int latency = t - pendingMicOnSince;
+                if (latency > 0) {
+                    result.delayedMicOnEvents++;
+                }
+                result.micOnLatencyTotal += latency;
+                result.micOnLatencyMax = std::max(result.micOnLatencyMax, latency);
+                pendingMicOnSince = -1;
+            }
+        }
+    }
+
+    return result;
+}
+
+void report(const char* label, const SimulationResult& result) {
+    double averageCostMs = result.stats.attempts
+        ? static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(result.stats.totalDuration).count()) /
+              result.stats.attempts
+        : 0.0;
+    std::printf("%-24s full reconnects %5u  avg cost %6.0f ms  total %6lld s  OS teardowns %5d  "
+                "RF drops %3u (kept warm %3d)  session resumes %3u  fallbacks %3d  "
+                "mic-on delayed %2d/%2d  avg %.2f s  max %d s  link up %5.1f%%\n",
+        label, result.stats.successes, averageCostMs,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(result.stats.totalDuration).count()),
+        result.osTeardowns, result.stats.linkDrops, result.keptWarmDrops, result.stats.sessionResumes,
+        result.fallbackReconnects,
+        result.delayedMicOnEvents, result.micOnEvents,
+        result.micOnEvents ? static_cast<double>(result.micOnLatencyTotal) / result.micOnEvents : 0.0,
+        result.micOnLatencyMax,
+        100.0 * result.linkUpSeconds / (SIMULATED_DAYS * SECONDS_PER_DAY));
+}
+
+// Most drops under a kept-warm session must come back without a full reconnect
+bool sessionAbsorbsDrops(const SimulationResult& result) {
+    return result.keptWarmDrops > 0 &&
+        result.stats.sessionResumes >= (1.0 - SESSION_RESTORE_FAILURE_RATE) * 0.8 * result.keptWarmDrops;
+}
+
+} // namespace
+
+int main() {
+    // The tick that sees the drop must not tear down a session that is still restoring
+    CHECK(decideReconnect(true, false, seconds(0), seconds(3600), seconds(RECONNECT_DELAY_SECONDS),
+              seconds(SCAN_TIMEOUT_SECONDS)) == ReconnectAction::Wait);
+    CHECK(decideReconnect(true, true, seconds(2), seconds(3600), seconds(RECONNECT_DELAY_SECONDS),
+              seconds(SCAN_TIMEOUT_SECONDS)) == ReconnectAction::ResumeSession);
+    CHECK(decideReconnect(true, false, seconds(SCAN_TIMEOUT_SECONDS), seconds(3600), seconds(RECONNECT_DELAY_SECONDS),
+              seconds(SCAN_TIMEOUT_SECONDS)) == ReconnectAction::FullReconnect);
+    CHECK(decideReconnect(false, false, seconds(0), seconds(1), seconds(RECONNECT_DELAY_SECONDS),
+              seconds(SCAN_TIMEOUT_SECONDS)) == ReconnectAction::Wait);
+
+    std::mt19937 scheduleRandom(2024);
+    auto meetings = makeMeetings(scheduleRandom);
+    auto rfDrops = makeRfDrops(scheduleRandom);
+
+    SimulationResult before = simulate(false, 0, meetings, rfDrops);
+    // The session as first shipped: no grace, so the drop tick went straight to a full reconnect
+    SimulationResult noGrace = simulate(true, 0, meetings, rfDrops);
+    SimulationResult after = simulate(true, SCAN_TIMEOUT_SECONDS, meetings, rfDrops);
+
+    std::printf("one simulated week, %zu meetings, %zu RF drops\n", meetings.size(), rfDrops.size());
+    report("before (no session):", before);
+    report("session, no grace:", noGrace);
+    report("session + grace window:", after);
+
+    // Work hours no longer churn through OS teardowns
+    CHECK(after.osTeardowns < before.osTeardowns);
+    CHECK(after.stats.successes < before.stats.successes);
+    // Drops under the session are absorbed by it - which the no-grace logic never manages
+    CHECK(sessionAbsorbsDrops(after));
+    CHECK(!sessionAbsorbsDrops(noGrace));
+    CHECK(after.stats.successes < noGrace.stats.successes);
+    // A session that never restores still ends in a full reconnect
+    CHECK(after.fallbackReconnects > 0);
+    CHECK_EQ(after.stats.sessionResumes + static_cast<uint32_t>(after.fallbackReconnects),
+        static_cast<uint32_t>(after.keptWarmDrops));
+    // Mic-on never waits longer with the session than without it
+    CHECK(after.micOnLatencyTotal <= before.micOnLatencyTotal);
+
+    return testResult("ReconnectSimulation");
+}
@@ -0,0 +1,183 @@
+// Covers the MicrophoneLEDMonitor.ini parser, the keep-warm window and the
+// snapshot store the config watcher publishes through.
+#include "RuntimeConfig.h"
+#include "TestSupport.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool parse(const std::string& text, RuntimeConfig& config, std::string& error) {
+    std::istringstream in(text);
+    return ParseRuntimeConfig(in, config, error);
+}
+
+std::tm localTime(int weekday, int hour) {
+    std::tm tm = {};
+    tm.tm_wday = weekday;
+    tm.tm_hour = hour;
+    return tm;
+}
+
+void testBuiltinProfiles() {
+    RuntimeConfig config;
+    std::string error;
+
+    CHECK(parse("", config, error));
+    CHECK_EQ(config.profile, std::string("balanced"));
+    CHECK(config.reconnectDelay == std::chrono::milliseconds(3000));
+    CHECK_EQ(config.gattRetries, 3);
+
+    CHECK(parse("profile = low-latency\n", config, error));
+    CHECK_EQ(config.profile, std::string("low-latency"));
+    CHECK(config.monitorInterval == std::chrono::milliseconds(250));
+    CHECK_EQ(config.gattRetries, 5);
+    CHECK(config.keepWarm.shouldKeepWarm(localTime(0, 3)));
+
+    CHECK(parse("# comment\n  profile=low-power  \r\n", config, error));
+    CHECK_EQ(config.profile, std::string("low-power"));
+    CHECK(config.statusUpdateInterval == std::chrono::milliseconds(120000));
+    CHECK_EQ(config.maxLogMessages, 50u);
+    CHECK(!config.keepWarm.shouldKeepWarm(localTime(2, 10)));
+}
+
+void testSectionOverrides() {
+    RuntimeConfig config;
+    std::string error;
+
+    // Only the selected profile's section applies
+    CHECK(parse("profile = low-latency\n"
+                "[low-latency]\n"
+                "monitor_interval_ms = 100\n"
+                "[low-power]\n"
+                "monitor_interval_ms = 5000\n",
+        config, error));
+    CHECK(config.monitorInterval == std::chrono::milliseconds(100));
+    CHECK(config.reconnectDelay == std::chrono::milliseconds(1000));
+
+    // A custom profile starts from balanced
+    CHECK(parse("profile = office\n"
+                "[office]\n"
+                "gatt_retries = 7\n",
+        config, error));
+    CHECK_EQ(config.profile, std::string("office"));
+    CHECK_EQ(config.gattRetries, 7);
+    CHECK(config.scanTimeout == std::chrono::milliseconds(8000));
+}
+
+void testRejectedFiles() {
+    RuntimeConfig config;
+    std::string error;
+
+    CHECK(!parse("[balanced]\nreconect_delay_ms = 500\n", config, error));
+    CHECK(error.find("unknown setting") != std::string::npos);
+
+    CHECK(!parse("[balanced]\ngatt_retries = 11\n", config, error));
+    CHECK(error.find("between 1 and 10") != std::string::npos);
+
+    CHECK(!parse("[balanced]\nscan_timeout_ms = 5s\n", config, error));
+    CHECK(error.find("not a number") != std::string::npos);
+
+    CHECK(!parse("profile = turbo\n", config, error));
+    CHECK(error.find("unknown profile") != std::string::npos);
+
+    CHECK(!parse("[balanced]\nmonitor_interval_ms\n", config, error));
+    CHECK(error.find("key = value") != std::string::npos);
+
+    // Equal hours would silently never keep warm
+    CHECK(!parse("[balanced]\nkeep_warm_start_hour = 9\nkeep_warm_end_hour = 9\n", config, error));
+    CHECK(!parse("[balanced]\nkeep_warm_start_hour = 24\nkeep_warm_end_hour = 6\n", config, error));
+}
+
+void testKeepWarmWindows() {
+    RuntimeConfig config;
+    std::string error;
+
+    // Overnight window: 20:00 through 05:59
+    CHECK(parse("[balanced]\nkeep_warm_start_hour = 20\nkeep_warm_end_hour = 6\nkeep_warm_weekdays_only = 0\n",
+        config, error));
+    CHECK(config.keepWarm.shouldKeepWarm(localTime(3, 20)));
+    CHECK(config.keepWarm.shouldKeepWarm(localTime(3, 23)));
+    CHECK(config.keepWarm.shouldKeepWarm(localTime(0, 0)));
+    CHECK(config.keepWarm.shouldKeepWarm(localTime(4, 5)));
+    CHECK(!config.keepWarm.shouldKeepWarm(localTime(4, 6)));
+    CHECK(!config.keepWarm.shouldKeepWarm(localTime(4, 12)));
+    CHECK(!config.keepWarm.shouldKeepWarm(localTime(4, 19)));
+
+    // Default office hours, weekdays only
+    KeepWarmPolicy office;
+    CHECK(office.shouldKeepWarm(localTime(1, 8)));
+    CHECK(!office.shouldKeepWarm(localTime(1, 18)));
+    CHECK(!office.shouldKeepWarm(localTime(6, 10)));
+}
+
+void testStoreKeepsPreviousSnapshot() {
+    RuntimeConfigStore store;
+    std::string error;
+    CHECK_EQ(store.get()->profile, std::string("balanced"));
+
+    std::istringstream good("profile = low-latency\n");
+    CHECK(store.apply(good, error));
+    auto applied = store.get();
+    CHECK_EQ(applied->profile, std::string("low-latency"));
+
+    std::istringstream bad("profile = low-power\n[low-power]\ngatt_retries = 0\n");
+    CHECK(!store.apply(bad, error));
+    CHECK(store.get() == applied);
+
+    // Deleting the file goes back to the defaults
+    store.reset();
+    CHECK_EQ(store.get()->profile, std::string("balanced"));
+    // Readers holding the old snapshot are unaffected
+    CHECK_EQ(applied->profile, std::string("low-latency"));
+}
+
+void testHotSwapWithReaders() {
+    const int READERS = 4;
+    const int SWAPS = 2000;
+    RuntimeConfigStore store;
+    std::atomic<bool> done{ false };
+    std::atomic<int> torn{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < READERS; i++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                // Every snapshot must be one whole profile, never a mix
+                auto config = store.get();
+                bool consistent = (config->profile == "balanced" && config->gattRetries == 3) ||
+                    (config->profile == "low-latency" && config->gattRetries == 5);
+                if (!consistent) {
+                    torn++;
+                }
+            }
+        });
+    }
+
+    std::string error;
+    for (int i = 0; i < SWAPS; i++) {
+        std::istringstream in(i % 2 == 0 ? "profile = low-latency\n" : "");
+        CHECK(store.apply(in, error));
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    CHECK_EQ(torn.load(), 0);
+}
+
+} // namespace
+
+int main() {
+    testBuiltinProfiles();
+    testSectionOverrides();
+    testRejectedFiles();
+    testKeepWarmWindows();
+    testStoreKeepsPreviousSnapshot();
+    testHotSwapWithReaders();
+    return testResult("RuntimeConfigTest");
+}
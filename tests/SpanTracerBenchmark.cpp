@@ -0,0 +1,50 @@
+// Measures the cost of a TraceSpan with tracing disabled (the normal state) and
+// enabled, against an empty loop baseline.
+#include "SpanTracer.h"
+#include "TestSupport.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+volatile uint64_t g_sink = 0;
+
+template <typename Body>
+double nsPerIteration(size_t iterations, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        body(i);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return elapsed / static_cast<double>(iterations);
+}
+
+} // namespace
+
+int main() {
+    const size_t ITERATIONS = 20000000;
+    Tracer tracer;
+
+    double baselineNs = nsPerIteration(ITERATIONS, [](size_t i) { g_sink = g_sink + i; });
+
+    double disabledNs = nsPerIteration(ITERATIONS, [&](size_t i) {
+        TraceSpan span(tracer, "monitor tick");
+        g_sink = g_sink + i;
+    });
+
+    tracer.setEnabled(true);
+    double enabledNs = nsPerIteration(ITERATIONS / 10, [&](size_t i) {
+        TraceSpan span(tracer, "monitor tick");
+        g_sink = g_sink + i;
+    });
+
+    std::printf("baseline loop:     %6.2f ns/iteration\n", baselineNs);
+    std::printf("span, disabled:    %6.2f ns/iteration\n", disabledNs);
+    std::printf("span, enabled:     %6.2f ns/iteration\n", enabledNs);
+
+    // Generous bound so the check is stable on loaded CI machines
+    CHECK(disabledNs - baselineNs < 5.0);
+
+    return testResult("SpanTracerBenchmark");
+}
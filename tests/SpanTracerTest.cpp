@@ -0,0 +1,96 @@
+#include "SpanTracer.h"
+#include "TestSupport.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+void testDisabledRecordsNothing() {
+    Tracer tracer;
+    {
+        TraceSpan span(tracer, "ignored");
+    }
+    std::ostringstream out;
+    CHECK_EQ(tracer.exportChromeTrace(out, 1), 0u);
+    CHECK_EQ(out.str(), std::string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n]}\n"));
+}
+
+void testJsonShape() {
+    Tracer tracer;
+    tracer.setEnabled(true);
+    {
+        TraceSpan outer(tracer, "connectToArduino");
+        TraceSpan inner(tracer, "scan");
+        inner.end();
+        inner.end(); // Second end() is a no-op
+    }
+
+    std::ostringstream out;
+    CHECK_EQ(tracer.exportChromeTrace(out, 1234), 2u);
+    std::string json = out.str();
+    CHECK_EQ(json.compare(0, 40, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"), 0);
+    CHECK_EQ(json.substr(json.size() - 4), std::string("\n]}\n"));
+    CHECK_EQ(countOccurrences(json, "\"ph\":\"X\""), 2u);
+    CHECK_EQ(countOccurrences(json, "\"pid\":1234"), 2u);
+    // Inner span closes first, so it is recorded first
+    CHECK(json.find("\"name\":\"scan\"") < json.find("\"name\":\"connectToArduino\""));
+}
+
+void testRingWrapKeepsNewestInOrder() {
+    Tracer tracer(4);
+    tracer.setEnabled(true);
+    const char* names[] = { "e0", "e1", "e2", "e3", "e4", "e5" };
+    for (int i = 0; i < 6; i++) {
+        tracer.record(names[i], i, 1);
+    }
+
+    std::ostringstream out;
+    CHECK_EQ(tracer.exportChromeTrace(out, 1), 4u);
+    std::string json = out.str();
+    CHECK(json.find("\"e0\"") == std::string::npos);
+    CHECK(json.find("\"e1\"") == std::string::npos);
+    size_t e2 = json.find("\"e2\"");
+    size_t e3 = json.find("\"e3\"");
+    size_t e4 = json.find("\"e4\"");
+    size_t e5 = json.find("\"e5\"");
+    CHECK(e2 != std::string::npos && e2 < e3 && e3 < e4 && e4 < e5);
+}
+
+void testPerThreadBuffersOutliveThreads() {
+    Tracer tracer;
+    tracer.setEnabled(true);
+    std::thread first([&]() { TraceSpan span(tracer, "worker"); });
+    first.join();
+    std::thread second([&]() { TraceSpan span(tracer, "worker"); });
+    second.join();
+
+    std::ostringstream out;
+    CHECK_EQ(tracer.exportChromeTrace(out, 1), 2u);
+    std::string json = out.str();
+    // Two distinct thread ids
+    size_t firstTid = json.find("\"tid\":");
+    size_t secondTid = json.find("\"tid\":", firstTid + 1);
+    CHECK(secondTid != std::string::npos);
+    CHECK(json.substr(firstTid, json.find('}', firstTid) - firstTid) !=
+          json.substr(secondTid, json.find('}', secondTid) - secondTid));
+}
+
+} // namespace
+
+int main() {
+    testDisabledRecordsNothing();
+    testJsonShape();
+    testRingWrapKeepsNewestInOrder();
+    testPerThreadBuffersOutliveThreads();
+    return testResult("SpanTracerTest");
+}
@@ -0,0 +1,693 @@
+// Exercises StateFanout and the SubscriberServer state machine shared with the
+// Windows named pipe broadcaster: first against a scripted transport that reports
+// completions on demand, then through a Unix domain socket transport with many
+// concurrent local clients, with poll() standing in for overlapped I/O.
+#include "StateFanout.h"
+#include "SubscriberServer.h"
+#include "TestSupport.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Scripted transport: connects, departures and write completions happen when the test says
+class ScriptedTransport {
+public:
+    struct Connection {
+        int client = -1;
+    };
+
+    std::deque<int> queued; // Clients that connected and wait to be accepted
+    std::set<int> departed; // Reads on these fail at once
+    std::set<int> failingWrites;
+    std::map<int, std::vector<std::string>> writes;
+    std::vector<int> closed;
+    bool listenPending = false;
+    bool failNextAccept = false;
+    int synchronousAccepts = 0;
+    int released = 0;
+
+    ListenResult listen() {
+        if (!queued.empty()) {
+            return ListenResult::Connected;
+        }
+        listenPending = true;
+        return ListenResult::Pending;
+    }
+
+    void cancelListen() {
+        listenPending = false;
+    }
+
+    bool accept(Connection& connection, bool synchronous) {
+        listenPending = false;
+        if (queued.empty()) {
+            return false;
+        }
+        int client = queued.front();
+        queued.pop_front();
+        if (failNextAccept) {
+            failNextAccept = false;
+            return false;
+        }
+        connection.client = client;
+        if (synchronous) {
+            synchronousAccepts++;
+        }
+        return true;
+    }
+
+    bool beginWrite(Connection& connection, const std::string& message) {
+        if (failingWrites.count(connection.client)) {
+            return false;
+        }
+        writes[connection.client].push_back(message);
+        return true;
+    }
+
+    bool beginRead(Connection& connection) {
+        return departed.count(connection.client) == 0;
+    }
+
+    void close(Connection& connection, bool, bool) {
+        closed.push_back(connection.client);
+    }
+
+    void release(Connection&) {
+        released++;
+    }
+
+    void log(const std::string&) {}
+};
+
+using ScriptedServer = SubscriberServer<ScriptedTransport>;
+
+size_t indexOf(ScriptedServer& server, int client) {
+    for (size_t i = 0; i < server.subscriberCount(); i++) {
+        if (server.subscriber(i).connection.client == client) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+bool isSubscribed(ScriptedServer& server, int client) {
+    return indexOf(server, client) != SIZE_MAX;
+}
+
+// Client arrives while the server waits on a pending listen
+void connectPending(ScriptedTransport& transport, ScriptedServer& server, int client) {
+    transport.queued.push_back(client);
+    if (transport.listenPending) {
+        server.connectCompleted();
+    }
+}
+
+void testCoalescing() {
+    StateFanout fanout;
+    StateFanout::Cursor cursor;
+    std::string message;
+
+    // Nothing to send before the first publish
+    CHECK(!fanout.nextWrite(cursor, message));
+
+    CHECK(fanout.publish({ true, MicState::Live, MicState::Live }));
+    CHECK(!fanout.publish({ true, MicState::Live, MicState::Live })); // Unchanged
+    CHECK(fanout.nextWrite(cursor, message));
+    CHECK_EQ(message, std::string("{\"seq\":1,\"connected\":true,\"mic\":\"live\",\"led\":\"live\"}\n"));
+
+    // While the write is in flight, further states coalesce into the newest one
+    fanout.publish({ true, MicState::Muted, MicState::Muted });
+    fanout.publish({ false, MicState::Idle, MicState::Idle });
+    CHECK(!fanout.nextWrite(cursor, message));
+    fanout.writeCompleted(cursor);
+    CHECK(fanout.nextWrite(cursor, message));
+    CHECK_EQ(message, std::string("{\"seq\":3,\"connected\":false,\"mic\":\"idle\",\"led\":\"off\"}\n"));
+    fanout.writeCompleted(cursor);
+    CHECK(!fanout.nextWrite(cursor, message));
+}
+
+void testServerSendsNewestAfterInFlightWrite() {
+    StateFanout fanout;
+    ScriptedTransport transport;
+    ScriptedServer server(transport, fanout, 8);
+    fanout.publish({ false, MicState::Idle, MicState::Idle });
+    server.start();
+
+    connectPending(transport, server, 1);
+    CHECK_EQ(transport.writes[1].size(), 1u); // Snapshot on connect, still in flight
+
+    for (int i = 0; i < 100; i++) {
+        MicState state = (i % 2 == 0) ? MicState::Live : MicState::Muted;
+        fanout.publish({ true, state, state });
+        server.stateChanged();
+    }
+    CHECK_EQ(transport.writes[1].size(), 1u); // Nothing queued behind the in-flight write
+
+    server.writeCompleted(indexOf(server, 1), true);
+    CHECK_EQ(transport.writes[1].size(), 2u);
+    CHECK_EQ(transport.writes[1].back(), formatSnapshot({ true, MicState::Muted, MicState::Muted }, 101));
+
+    server.writeCompleted(indexOf(server, 1), true);
+    CHECK_EQ(transport.writes[1].size(), 2u); // Caught up
+}
+
+void testSynchronousConnects() {
+    StateFanout fanout;
+    ScriptedTransport transport;
+    ScriptedServer server(transport, fanout, 8);
+    fanout.publish({ true, MicState::Live, MicState::Live });
+
+    // Clients that connected before the server listened (ERROR_PIPE_CONNECTED)
+    transport.queued = { 1, 2, 3 };
+    server.start();
+    CHECK_EQ(server.subscriberCount(), 3u);
+    CHECK_EQ(transport.synchronousAccepts, 3);
+    CHECK(server.isListening());
+    for (int client = 1; client <= 3; client++) {
+        CHECK_EQ(transport.writes[client].size(), 1u);
+    }
+
+    // A failed connect is dropped and the server keeps listening
+    transport.failNextAccept = true;
+    connectPending(transport, server, 4);
+    CHECK(!isSubscribed(server, 4));
+    CHECK(server.isListening());
+    connectPending(transport, server, 5);
+    CHECK(isSubscribed(server, 5));
+}
+
+void testDepartureWithoutPublish() {
+    StateFanout fanout;
+    ScriptedTransport transport;
+    ScriptedServer server(transport, fanout, 8);
+    fanout.publish({ true, MicState::Live, MicState::Live });
+    server.start();
+    connectPending(transport, server, 1);
+    connectPending(transport, server, 2);
+    server.writeCompleted(indexOf(server, 1), true);
+
+    // The posted read fails when the client goes away - no state change involved
+    server.readCompleted(indexOf(server, 1), false);
+    server.removeDisconnected();
+    CHECK(!isSubscribed(server, 1));
+    CHECK_EQ(transport.closed, std::vector<int>{ 1 });
+    CHECK_EQ(transport.released, 1);
+    CHECK_EQ(transport.writes[1].size(), 1u);
+
+    // A client that has already gone by the time its first read is posted
+    transport.departed.insert(3);
+    connectPending(transport, server, 3);
+    server.removeDisconnected();
+    CHECK(!isSubscribed(server, 3));
+
+    // Data from a client is ignored and the read is posted again
+    server.readCompleted(indexOf(server, 2), true);
+    CHECK(server.subscriber(indexOf(server, 2)).readPending);
+
+    // A failed write closes the subscriber too
+    transport.failingWrites.insert(2);
+    server.writeCompleted(indexOf(server, 2), true);
+    fanout.publish({ true, MicState::Muted, MicState::Muted });
+    server.stateChanged();
+    server.removeDisconnected();
+    CHECK_EQ(server.subscriberCount(), 0u);
+}
+
+void testFullServerListensAgainWhenSlotFrees() {
+    const size_t MAX = 2;
+    StateFanout fanout;
+    ScriptedTransport transport;
+    ScriptedServer server(transport, fanout, MAX);
+    fanout.publish({ true, MicState::Live, MicState::Live });
+    server.start();
+
+    connectPending(transport, server, 1);
+    connectPending(transport, server, 2);
+    CHECK_EQ(server.subscriberCount(), MAX);
+    CHECK(!server.isListening());
+
+    // Waits in the backlog while every slot is taken
+    transport.queued.push_back(3);
+    server.stateChanged();
+    CHECK(!isSubscribed(server, 3));
+
+    server.readCompleted(indexOf(server, 1), false);
+    server.removeDisconnected();
+    CHECK(isSubscribed(server, 3));
+    CHECK_EQ(server.subscriberCount(), MAX);
+    CHECK_EQ(transport.synchronousAccepts, 1);
+    CHECK_EQ(transport.writes[3].size(), 1u);
+
+    server.shutdown();
+    CHECK_EQ(server.subscriberCount(), 0u);
+    CHECK_EQ(transport.released, 3);
+}
+
+// Unix socket transport - accept() on a queued client plays the part of
+// ERROR_PIPE_CONNECTED, POLLIN stands in for the posted read and POLLOUT for the
+// overlapped write completion
+class UnixSocketTransport {
+public:
+    struct Connection {
+        int fd = -1;
+        const std::string* message = nullptr;
+        size_t offset = 0;
+    };
+
+    int listenFd = -1;
+    std::atomic<int> synchronousAccepts{ 0 };
+
+    ListenResult listen() {
+        queuedFd = ::accept(listenFd, nullptr, nullptr);
+        return queuedFd >= 0 ? ListenResult::Connected : ListenResult::Pending;
+    }
+
+    void cancelListen() {}
+
+    bool accept(Connection& connection, bool synchronous) {
+        int fd = synchronous ? queuedFd : ::accept(listenFd, nullptr, nullptr);
+        queuedFd = -1;
+        if (fd < 0) {
+            return false;
+        }
+        if (synchronous) {
+            synchronousAccepts++;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        connection.fd = fd;
+        return true;
+    }
+
+    // Completion is always reported through POLLOUT, even when everything went out now
+    bool beginWrite(Connection& connection, const std::string& message) {
+        connection.message = &message;
+        connection.offset = 0;
+        return flush(connection) >= 0;
+    }
+
+    // -1 failed, 0 still pending, 1 done
+    int flush(Connection& connection) {
+        while (connection.offset < connection.message->size()) {
+            ssize_t written = send(connection.fd, connection.message->data() + connection.offset,
+                connection.message->size() - connection.offset, MSG_NOSIGNAL);
+            if (written < 0) {
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+            }
+            connection.offset += static_cast<size_t>(written);
+        }
+        return 1;
+    }
+
+    bool beginRead(Connection&) {
+        return true; // POLLIN interest while the read is pending
+    }
+
+    bool finishRead(Connection& connection) {
+        char ignored[64];
+        ssize_t count = read(connection.fd, ignored, sizeof(ignored));
+        return count > 0 || (count < 0 && errno == EAGAIN);
+    }
+
+    void close(Connection& connection, bool, bool) {
+        ::close(connection.fd);
+        connection.fd = -1;
+    }
+
+    void release(Connection&) {}
+
+    void log(const std::string&) {}
+
+private:
+    int queuedFd = -1;
+};
+
+class SocketFanoutServer {
+public:
+    SocketFanoutServer(const std::string& path, size_t maxSubscribers)
+        : path(path), server(transport, fanout, maxSubscribers) {
+        unlink(path.c_str());
+        transport.listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        bind(transport.listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        ::listen(transport.listenFd, 128);
+        fcntl(transport.listenFd, F_SETFL, O_NONBLOCK);
+
+        int fds[2];
+        CHECK(pipe(fds) == 0);
+        wakeRead = fds[0];
+        wakeWrite = fds[1];
+        fcntl(wakeRead, F_SETFL, O_NONBLOCK);
+        fcntl(wakeWrite, F_SETFL, O_NONBLOCK);
+
+        thread = std::thread(&SocketFanoutServer::serverLoop, this);
+    }
+
+    ~SocketFanoutServer() {
+        stopping = true;
+        wake();
+        thread.join();
+        close(transport.listenFd);
+        close(wakeRead);
+        close(wakeWrite);
+        unlink(path.c_str());
+    }
+
+    // Producer side - must never block on subscribers
+    void publish(const MonitorSnapshot& snapshot) {
+        if (fanout.publish(snapshot)) {
+            wake();
+        }
+    }
+
+    size_t subscriberCount() const {
+        return liveSubscribers;
+    }
+
+    int synchronousAccepts() const {
+        return transport.synchronousAccepts;
+    }
+
+private:
+    std::string path;
+    int wakeRead = -1;
+    int wakeWrite = -1;
+    std::atomic<bool> stopping{ false };
+    std::atomic<size_t> liveSubscribers{ 0 };
+    StateFanout fanout;
+    UnixSocketTransport transport;
+    SubscriberServer<UnixSocketTransport> server;
+    std::thread thread;
+
+    void wake() {
+        char byte = 1;
+        ssize_t ignored = write(wakeWrite, &byte, 1);
+        (void)ignored;
+    }
+
+    void serverLoop() {
+        server.start();
+        std::vector<pollfd> fds;
+        while (!stopping) {
+            fds.clear();
+            fds.push_back({ wakeRead, POLLIN, 0 });
+            fds.push_back({ server.isListening() ? transport.listenFd : -1, POLLIN, 0 });
+            for (size_t i = 0; i < server.subscriberCount(); i++) {
+                auto& subscriber = server.subscriber(i);
+                short events = 0;
+                if (subscriber.readPending) {
+                    events |= POLLIN;
+                }
+                if (subscriber.cursor.writePending) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({ subscriber.open ? subscriber.connection.fd : -1, events, 0 });
+            }
+
+            if (poll(fds.data(), fds.size(), 100) < 0) {
+                continue;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                char drain[64];
+                while (read(wakeRead, drain, sizeof(drain)) > 0) {
+                }
+                server.stateChanged();
+            }
+
+            if (fds[1].revents & POLLIN) {
+                server.connectCompleted();
+            }
+
+            for (size_t i = 2; i < fds.size(); i++) {
+                size_t index = i - 2;
+                auto& subscriber = server.subscriber(index);
+                if (subscriber.open && subscriber.readPending && (fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                    server.readCompleted(index, transport.finishRead(subscriber.connection));
+                }
+                if (subscriber.open && subscriber.cursor.writePending && (fds[i].revents & POLLOUT)) {
+                    int flushed = transport.flush(subscriber.connection);
+                    if (flushed != 0) {
+                        server.writeCompleted(index, flushed > 0);
+                    }
+                }
+            }
+
+            server.removeDisconnected();
+            liveSubscribers = server.subscriberCount();
+        }
+        server.shutdown();
+    }
+};
+
+int connectClient(const std::string& path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// What one client saw on the wire
+struct ClientLog {
+    int lines = 0;
+    uint64_t lastSequence = 0;
+    bool ordered = true; // Every line had a higher seq than the one before
+    std::string lastLine;
+};
+
+uint64_t parseSequence(const std::string& line) {
+    const std::string prefix = "{\"seq\":";
+    if (line.compare(0, prefix.size(), prefix) != 0) {
+        return 0;
+    }
+    return std::stoull(line.substr(prefix.size()));
+}
+
+// Reads lines until one carries the wanted sequence number (or the deadline passes)
+bool readUntilSequence(int fd, uint64_t wanted, ClientLog& log) {
+    std::string pending;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    char chunk[4096];
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+        ssize_t count = read(fd, chunk, sizeof(chunk));
+        if (count <= 0) {
+            return false;
+        }
+        pending.append(chunk, static_cast<size_t>(count));
+
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string::npos) {
+            log.lastLine = pending.substr(0, newline);
+            pending.erase(0, newline + 1);
+            log.lines++;
+            uint64_t sequence = parseSequence(log.lastLine);
+            if (sequence <= log.lastSequence) {
+                log.ordered = false;
+            }
+            log.lastSequence = sequence;
+            if (sequence == wanted) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Nothing arrives on fd within the timeout
+bool staysSilent(int fd, int timeoutMs) {
+    pollfd pfd = { fd, POLLIN, 0 };
+    return poll(&pfd, 1, timeoutMs) == 0;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+std::string socketPath(const char* name) {
+    return "/tmp/mic-fanout-" + std::string(name) + "-" + std::to_string(getpid()) + ".sock";
+}
+
+void testManyConcurrentClients() {
+    const std::string path = socketPath("many");
+    const int CLIENTS = 64;
+    const int SLOW_CLIENTS = 4;
+    const int EARLY_EXIT_CLIENTS = 16;
+    const int PUBLISHES = 20000;
+
+    SocketFanoutServer server(path, 128);
+    server.publish({ false, MicState::Idle, MicState::Idle });
+
+    // Slow consumers connect and do not read until every publish is done
+    std::vector<int> slowClients;
+    for (int i = 0; i < SLOW_CLIENTS; i++) {
+        int fd = connectClient(path);
+        CHECK(fd >= 0);
+        slowClients.push_back(fd);
+    }
+
+    // Short-lived tools read the snapshot they get on connect and leave
+    std::atomic<int> snapshotsOnConnect{ 0 };
+    std::vector<std::thread> earlyExit;
+    for (int i = 0; i < EARLY_EXIT_CLIENTS; i++) {
+        earlyExit.emplace_back([&]() {
+            int fd = connectClient(path);
+            if (fd < 0) {
+                return;
+            }
+            ClientLog log;
+            if (readUntilSequence(fd, 1, log) &&
+                log.lastLine == "{\"seq\":1,\"connected\":false,\"mic\":\"idle\",\"led\":\"off\"}") {
+                snapshotsOnConnect++;
+            }
+            close(fd);
+        });
+    }
+    for (auto& thread : earlyExit) {
+        thread.join();
+    }
+    CHECK_EQ(snapshotsOnConnect.load(), EARLY_EXIT_CLIENTS);
+
+    // Long-lived subscribers follow every change to the end
+    uint64_t finalSequence = 1 + PUBLISHES;
+    std::atomic<int> ready{ 0 };
+    std::vector<ClientLog> logs(CLIENTS);
+    std::vector<bool> caughtUp(CLIENTS, false);
+    std::vector<std::thread> clients;
+    for (int i = 0; i < CLIENTS; i++) {
+        clients.emplace_back([&, i]() {
+            int fd = connectClient(path);
+            if (fd < 0) {
+                return;
+            }
+            ready++;
+            caughtUp[i] = readUntilSequence(fd, finalSequence, logs[i]);
+            close(fd);
+        });
+    }
+    while (ready < CLIENTS) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // The producer must not be slowed down by the subscribers that never read
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PUBLISHES; i++) {
+        MicState state = (i % 2 == 0) ? MicState::Live : MicState::Muted;
+        server.publish({ true, state, state });
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(elapsed < std::chrono::seconds(1));
+
+    for (auto& thread : clients) {
+        thread.join();
+    }
+
+    // The last publish (odd index) was muted; everyone ends on exactly that line
+    const std::string finalLine = "{\"seq\":" + std::to_string(finalSequence) +
+        ",\"connected\":true,\"mic\":\"muted\",\"led\":\"muted\"}";
+    for (int i = 0; i < CLIENTS; i++) {
+        CHECK(caughtUp[i]);
+        CHECK(logs[i].ordered);
+        CHECK_EQ(logs[i].lastLine, finalLine);
+    }
+
+    // Clients that stopped reading were never queued every publish: they get what
+    // fit in the socket buffer, then the newest state once they read again
+    for (int fd : slowClients) {
+        ClientLog log;
+        CHECK(readUntilSequence(fd, finalSequence, log));
+        CHECK(log.ordered);
+        CHECK_EQ(log.lastLine, finalLine);
+        CHECK(log.lines < PUBLISHES / 2);
+    }
+
+    // Departed clients are noticed without waiting for another state change
+    for (int fd : slowClients) {
+        close(fd);
+    }
+    CHECK(waitFor([&]() { return server.subscriberCount() == 0; }));
+}
+
+// Clients beyond the limit wait in the backlog and are taken as soon as a slot frees
+void testSubscriberLimit() {
+    const std::string path = socketPath("limit");
+    const size_t MAX = 4;
+
+    SocketFanoutServer server(path, MAX);
+    server.publish({ true, MicState::Live, MicState::Live });
+
+    std::vector<int> clients;
+    for (size_t i = 0; i < MAX; i++) {
+        int fd = connectClient(path);
+        CHECK(fd >= 0);
+        ClientLog log;
+        CHECK(readUntilSequence(fd, 1, log));
+        clients.push_back(fd);
+    }
+    CHECK(waitFor([&]() { return server.subscriberCount() == MAX; }));
+
+    int waiting = connectClient(path);
+    CHECK(waiting >= 0);
+    CHECK(staysSilent(waiting, 200));
+    CHECK_EQ(server.subscriberCount(), MAX);
+
+    // The waiting client was already connected when the server listened again
+    int acceptedBefore = server.synchronousAccepts();
+    close(clients.front());
+    ClientLog log;
+    CHECK(readUntilSequence(waiting, 1, log));
+    CHECK_EQ(server.synchronousAccepts(), acceptedBefore + 1);
+    CHECK(waitFor([&]() { return server.subscriberCount() == MAX; }));
+
+    close(waiting);
+    for (size_t i = 1; i < clients.size(); i++) {
+        close(clients[i]);
+    }
+    CHECK(waitFor([&]() { return server.subscriberCount() == 0; }));
+}
+
+} // namespace
+
+int main() {
+    signal(SIGPIPE, SIG_IGN);
+    testCoalescing();
+    testServerSendsNewestAfterInFlightWrite();
+    testSynchronousConnects();
+    testDepartureWithoutPublish();
+    testFullServerListensAgainWhenSlotFrees();
+    testManyConcurrentClients();
+    testSubscriberLimit();
+    return testResult("StateFanoutTest");
+}
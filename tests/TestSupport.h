@@ -0,0 +1,29 @@
+#pragma once
+
+// Minimal assertion helpers for the host-side tests - no external framework needed
+#include <iostream>
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                              \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition \
+                      << std::endl;                                                   \
+            testFailures()++;                                                         \
+        }                                                                             \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CHECK((actual) == (expected))
+
+inline int testResult(const char* suite) {
+    if (testFailures() == 0) {
+        std::cout << suite << ": all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << suite << ": " << testFailures() << " check(s) failed" << std::endl;
+    return 1;
+}